@@ -0,0 +1,72 @@
+// Total throughput of one sequence shared by many threads: one engine behind a mutex
+// against shared_block_engine (each thread generating the runs of blocks it claims).
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "freestanding_mersenne_twister.h"
+#include "freestanding_mersenne_twister_threads.h"
+
+namespace {
+
+using engine = freestanding_mersenne_twister::mt19937_64<>;
+using shared_engine = freestanding_mersenne_twister::shared_block_engine<engine>;
+
+template<class MakeDraw>
+double draws_per_second(unsigned thread_count, unsigned long long draws_per_thread, MakeDraw make_draw) {
+    std::vector<std::thread> threads;
+    std::vector<engine::result_type> sinks(thread_count);
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&sinks, &make_draw, t, draws_per_thread] {
+            auto draw = make_draw();
+            engine::result_type sink = 0;
+            for (unsigned long long k = 0; k < draws_per_thread; ++k) {
+                sink ^= draw();
+            }
+            sinks[t] = sink;
+        });
+    }
+    for (std::thread& t : threads) t.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(draws_per_thread) * thread_count / elapsed.count();
+}
+
+}
+
+int main(int argc, char** argv) {
+    // Enough for each thread to claim several runs, so the jumps between them are part of the timings
+    const unsigned long long draws_per_thread = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 8u * shared_engine::run_blocks * shared_engine::block_size;
+    const unsigned max_threads = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 4u;
+
+    {
+        // Constructs the jumps the handles need, so that is not part of the timings
+        shared_engine shared(5489u);
+        draws_per_second(max_threads, 2u * shared_engine::run_blocks * shared_engine::block_size, [&shared] {
+            return shared_engine::handle(shared);
+        });
+    }
+
+    std::printf("%8s %20s %20s\n", "threads", "mutex (draws/s)", "shared (draws/s)");
+    for (unsigned thread_count = 1; thread_count <= max_threads; thread_count *= 2u) {
+        std::mutex mutex;
+        engine locked_engine(5489u);
+        const double locked = draws_per_second(thread_count, draws_per_thread, [&mutex, &locked_engine] {
+            return [&mutex, &locked_engine] {
+                std::lock_guard<std::mutex> lock(mutex);
+                return locked_engine();
+            };
+        });
+
+        shared_engine shared(5489u);
+        const double blocks = draws_per_second(thread_count, draws_per_thread, [&shared] {
+            return shared_engine::handle(shared);
+        });
+
+        std::printf("%8u %20.4g %20.4g\n", thread_count, locked, blocks);
+    }
+}
@@ -0,0 +1,43 @@
+// Time to shuffle an array with std::shuffle and std::mt19937_64, against freestanding_mersenne_twister::shuffle
+// with mt19937_64<> (batched bounded draws from the block path, with prefetched swap targets).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "freestanding_mersenne_twister.h"
+
+namespace {
+
+template<class Shuffle>
+double seconds(std::vector<unsigned>& v, Shuffle shuffle) {
+    std::iota(v.begin(), v.end(), 0u);
+    const auto start = std::chrono::steady_clock::now();
+    shuffle(v);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+}
+
+int main(int argc, char** argv) {
+    const unsigned long long max_size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000'000u;
+
+    std::printf("%12s %16s %16s\n", "elements", "std (s)", "batched (s)");
+    for (unsigned long long size = 1'000u; size <= max_size; size *= 10u) {
+        std::vector<unsigned> v(size);
+        const double standard = seconds(v, [](std::vector<unsigned>& v) {
+            std::mt19937_64 e(5489u);
+            std::shuffle(v.begin(), v.end(), e);
+        });
+        const double batched = seconds(v, [](std::vector<unsigned>& v) {
+            freestanding_mersenne_twister::mt19937_64<> e(5489u);
+            freestanding_mersenne_twister::shuffle(v.begin(), v.end(), e);
+        });
+        std::printf("%12llu %16.4g %16.4g\n", size, standard, batched);
+    }
+}
@@ -0,0 +1,64 @@
+// Throughput of drawing from many threads at once: one shared engine behind a mutex
+// against thread_engine_registry (one engine per thread, each on its own substream).
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "freestanding_mersenne_twister.h"
+#include "freestanding_mersenne_twister_threads.h"
+
+namespace {
+
+using engine = freestanding_mersenne_twister::mt19937_64<>;
+using registry = freestanding_mersenne_twister::thread_engine_registry<engine>;
+
+template<class Draw>
+double draws_per_second(unsigned thread_count, unsigned long long draws_per_thread, Draw draw) {
+    std::vector<std::thread> threads;
+    std::vector<engine::result_type> sinks(thread_count);
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&sinks, &draw, t, draws_per_thread] {
+            engine::result_type sink = 0;
+            for (unsigned long long k = 0; k < draws_per_thread; ++k) {
+                sink ^= draw();
+            }
+            sinks[t] = sink;
+        });
+    }
+    for (std::thread& t : threads) t.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(draws_per_thread) * thread_count / elapsed.count();
+}
+
+}
+
+int main(int argc, char** argv) {
+    const unsigned long long draws_per_thread = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000u;
+    const unsigned max_threads = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 2u * std::thread::hardware_concurrency();
+
+    // Computes the substream jump once, so it is not part of the timings
+    registry::seed(5489u);
+    static_cast<void>(registry::substream(1));
+
+    std::printf("%8s %20s %20s\n", "threads", "mutex (draws/s)", "registry (draws/s)");
+    for (unsigned thread_count = 1; thread_count <= max_threads; thread_count *= 2u) {
+        std::mutex mutex;
+        engine shared(5489u);
+        const double locked = draws_per_second(thread_count, draws_per_thread, [&mutex, &shared] {
+            std::lock_guard<std::mutex> lock(mutex);
+            return shared();
+        });
+
+        registry::seed(5489u);
+        const double per_thread = draws_per_second(thread_count, draws_per_thread, [] {
+            return registry::local()();
+        });
+
+        std::printf("%8u %20.4g %20.4g\n", thread_count, locked, per_thread);
+    }
+}
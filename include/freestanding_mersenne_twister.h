@@ -1,9 +1,21 @@
 #ifndef FREESTANDING_MERSENNE_TWISTER_H
 #define FREESTANDING_MERSENNE_TWISTER_H 1'01
 
-namespace freestanding_mersenne_twister {
+#ifndef FREESTANDING_MERSENNE_TWISTER_CACHE_LINE_SIZE
+// Default alignment of the elements of engine_array (like std::hardware_destructive_interference_size,
+// which is not available without the standard library)
+#define FREESTANDING_MERSENNE_TWISTER_CACHE_LINE_SIZE 64
+#endif
+
+#ifndef FREESTANDING_MERSENNE_TWISTER_EXPORT
+// Defined as `export` when this header is included by module/freestanding_mersenne_twister.cppm
+#define FREESTANDING_MERSENNE_TWISTER_EXPORT
+#endif
+
+FREESTANDING_MERSENNE_TWISTER_EXPORT namespace freestanding_mersenne_twister {
 
 using size_t = decltype(sizeof(char));
+using ptrdiff_t = decltype(static_cast<char*>(nullptr) - static_cast<char*>(nullptr));
 
 namespace detail {
 
@@ -25,6 +37,9 @@ namespace detail {
     }
 #endif
 
+    template<bool B, class IfTrue, class IfFalse> struct conditional { using type = IfFalse; };
+    template<class IfTrue, class IfFalse> struct conditional<true, IfTrue, IfFalse> { using type = IfTrue; };
+
 #ifndef FREESTANDING_MERSENNE_TWISTER_NO_SEED_SEQUENCE
     template<bool B> struct bool_constant { static constexpr bool value = B; };
 
@@ -40,9 +55,6 @@ namespace detail {
         return is_unsigned_integer_of_at_least_32_bits<T>() && (static_cast<unsigned long long>(static_cast<T>(0xffff'ffff'ffff'ffffu)) == 0xffff'ffff'ffff'ffffu);
     }
 
-    template<bool B, class IfTrue, class IfFalse> struct conditional { using type = IfFalse; };
-    template<class IfTrue, class IfFalse> struct conditional<true, IfTrue, IfFalse> { using type = IfTrue; };
-
     template<class... Candidates> struct smallest_32_bit_type { using type = unsigned long; };
     template<class Candidate, class... Candidates>
     struct smallest_32_bit_type<Candidate, Candidates...> : conditional<is_unsigned_integer_of_at_least_32_bits<Candidate>(), Candidate, typename smallest_32_bit_type<Candidates...>::type> {};
@@ -183,6 +195,13 @@ struct mersenne_twister_state {
     }
 };
 
+template<class Engine>
+struct mersenne_twister_jump;
+template<class Engine>
+struct lazy_seed_engine;
+template<class UIntType>
+struct dynamic_mersenne_twister_engine;
+
 template<class UIntType, size_t w, size_t n, size_t m, size_t r, UIntType a, size_t u, UIntType d, size_t s, UIntType b, size_t t, UIntType c, size_t l, UIntType f>
 struct mersenne_twister_engine : public mersenne_twister_state<UIntType, n> {
     using result_type = UIntType;
@@ -210,7 +229,8 @@ struct mersenne_twister_engine : public mersenne_twister_state<UIntType, n> {
 private:
     static constexpr size_t result_type_bits = detail::bits_in_type<result_type>();
     static_assert(word_size <= result_type_bits, "result_type is too small for word_size bits");
-    static constexpr result_type max_value{ (~result_type{0}) >> (result_type_bits - w) };
+    // (The casts and the `1u *`s below are for result_types narrower than int, which would otherwise be promoted to int)
+    static constexpr result_type max_value{ static_cast<result_type>(static_cast<result_type>(~result_type{0}) >> (result_type_bits - w)) };
 
 public:
     static constexpr result_type default_seed{ static_cast<result_type>(5489u) & max() };
@@ -279,7 +299,7 @@ public:
     void seed(result_type value = default_seed) noexcept {
         X[0] = value & max();
         for (size_t j = 1; j < state_size; ++j) {
-            X[j] = (initialization_multiplier * (X[j-1u] xor (X[j-1u] >> (word_size - 2u))) + j) & max();
+            X[j] = initialization_step(X[j-1u], j);
         }
 
         transition_algorithm();
@@ -313,6 +333,18 @@ public:
     state_type& state() & noexcept { return *this; }
 
 private:
+    template<class Engine>
+    friend struct mersenne_twister_jump;
+    template<class Engine>
+    friend struct lazy_seed_engine;
+    template<class UIntType2>
+    friend struct dynamic_mersenne_twister_engine;
+
+    // X[j] of the initial state from X[j-1] when seeding with a single value
+    static constexpr result_type initialization_step(result_type previous, size_t j) noexcept {
+        return static_cast<result_type>((1u * initialization_multiplier * (previous xor (previous >> (word_size - 2u))) + j) & max());
+    }
+
     template<size_t Amount>
     static constexpr result_type rshift(result_type value) noexcept {
 #if __cpp_if_constexpr >= 201606L && __cpp_constexpr >= 201304L
@@ -333,43 +365,70 @@ private:
         if constexpr (Amount >= word_size) {
             return min();
         } else {
-            return value << Amount;
+            return static_cast<result_type>(1u * value << Amount);
         }
 #else
-        return (Amount >= word_size) ? min() : value << Amount;
+        return (Amount >= word_size) ? min() : static_cast<result_type>(1u * value << Amount);
 #endif
     }
 
+    static constexpr result_type twist(result_type x_i, result_type x_i_plus_1, result_type x_i_plus_m) noexcept {
 #if __cpp_constexpr >= 201304L
-    constexpr
-#endif
-    void transition_algorithm() noexcept {
         constexpr result_type upper_bits_mask{ lshift<mask_bits>(max()) & max() };
         constexpr result_type lower_bits_mask{ max() ^ upper_bits_mask };
+        const result_type Y = (x_i & upper_bits_mask) | (x_i_plus_1 & lower_bits_mask);
+        return x_i_plus_m xor (Y >> 1) xor (xor_mask * (Y bitand 1u));
+#else
+        return twist_impl((x_i & (lshift<mask_bits>(max()) & max())) | (x_i_plus_1 & (max() ^ (lshift<mask_bits>(max()) & max()))), x_i_plus_m);
+#endif
+    }
+#if __cpp_constexpr < 201304L
+    static constexpr result_type twist_impl(result_type Y, result_type x_i_plus_m) noexcept {
+        return x_i_plus_m xor (Y >> 1) xor (xor_mask * (Y bitand 1u));
+    }
+#endif
 
-        for (size_t i = 0; i < state_size; ++i) {
-            result_type Y = (X[i] & upper_bits_mask) | (X[static_cast<size_t>(i+1u) % state_size] & lower_bits_mask);
-            result_type alpha = xor_mask * (Y bitand 1u);
-            X[i] = X[(i + shift_size) % state_size] xor (Y >> 1) xor alpha;
+    // Writes the block following `src` to `dest`. `src` and `dest` may be the same array.
+    static
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void transition_block(const result_type* src, result_type* dest) noexcept {
+        if (shift_size == state_size) {
+            // X[i+m] is X[i] itself, so it is always the old value
+            for (size_t i = 0; i < state_size - 1u; ++i) {
+                dest[i] = twist(src[i], src[i+1u], src[i]);
+            }
+            dest[state_size - 1u] = twist(src[state_size - 1u], state_size == 1u ? src[0] : dest[0], src[state_size - 1u]);
+            return;
         }
 
-        /*
         for (size_t i = 0; i < (state_size - shift_size); ++i) {
-            result_type Y = (X[i] & upper_bits_mask) | (X[i+1u] & lower_bits_mask);
-            result_type alpha = xor_mask * (Y bitand 1u);
-            X[i] = X[i + shift_size] xor (Y >> 1) xor alpha;
+            dest[i] = twist(src[i], src[i+1u], src[i + shift_size]);
         }
 
         for (size_t i = (state_size - shift_size); i < state_size - 1u; ++i) {
-            result_type Y = (X[i] & upper_bits_mask) | (X[i+1u] & lower_bits_mask);
-            result_type alpha = xor_mask * (Y bitand 1u);
-            X[i] = X[i + (shift_size - state_size)] xor (Y >> 1) xor alpha;
+            dest[i] = twist(src[i], src[i+1u], dest[i - (state_size - shift_size)]);
         }
 
-        result_type Y = (X[state_size - 1u] & upper_bits_mask) | (X[0] & lower_bits_mask);
-        result_type alpha = xor_mask * (Y bitand 1u);
-        X[state_size - 1u] = X[shift_size - 1u] xor (Y >> 1) xor alpha;
-         */
+        dest[state_size - 1u] = twist(src[state_size - 1u], dest[0], dest[shift_size - 1u]);
+    }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void transition_algorithm() noexcept {
+        transition_block(X, X);
+    }
+
+    static
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void scramble_block(result_type* first, result_type* last) noexcept {
+        for (; first != last; ++first) {
+            *first = scramble(*first);
+        }
     }
 public:
     static
@@ -387,6 +446,104 @@ public:
         return z;
     }
 
+private:
+    // Inverse of `z xor (rshift<Amount>(z) bitand Mask)`: each iteration recovers `Amount` more high bits
+    template<size_t Amount, result_type Mask>
+    static
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type unshift_right(result_type y) noexcept {
+        static_assert(Amount != 0u || Mask == 0u, "scramble is not invertible (a right shift of 0 with a non-zero mask)");
+        // (A shift of 0 with a zero mask does nothing, and would never finish the loop)
+        if (Amount == 0u) return y;
+        result_type z = y;
+        for (size_t bits = Amount; bits < word_size; bits += Amount) {
+            z = y xor (rshift<Amount>(z) bitand Mask);
+        }
+        return z;
+    }
+
+    // Inverse of `z xor (lshift<Amount>(z) bitand Mask)`: each iteration recovers `Amount` more low bits
+    template<size_t Amount, result_type Mask>
+    static
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type unshift_left(result_type y) noexcept {
+        static_assert(Amount != 0u || Mask == 0u, "scramble is not invertible (a left shift of 0 with a non-zero mask)");
+        // (A shift of 0 with a zero mask does nothing, and would never finish the loop)
+        if (Amount == 0u) return y;
+        result_type z = y;
+        for (size_t bits = Amount; bits < word_size; bits += Amount) {
+            z = y xor (lshift<Amount>(z) bitand Mask);
+        }
+        return z;
+    }
+
+    static
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void reverse(result_type* first, result_type* last) noexcept {
+        while (first != last && first != --last) {
+            result_type tmp = *first;
+            *first++ = *last;
+            *last = tmp;
+        }
+    }
+
+public:
+    /*
+     * The inverse of scramble: `unscramble(scramble(x)) == x` for all x in [min(), max()].
+     * Branch free with a fixed number of iterations for each step, so loops over it vectorize.
+     * Ill-formed if scramble is not a bijection (a shift of 0 with a non-zero mask).
+     */
+    static
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type unscramble(result_type x) noexcept {
+        static_assert(tempering_l != 0u, "scramble is not invertible (tempering_l is 0)");
+        result_type z = x & max();
+        z = unshift_right<tempering_l, max_value>(z);
+        z = unshift_left<tempering_t, tempering_c>(z);
+        z = unshift_left<tempering_s, tempering_b>(z);
+        z = unshift_right<tempering_u, tempering_d>(z);
+
+        return z;
+    }
+
+    /*
+     * Reconstructs an engine from a log of consecutive outputs of some engine with the same parameters.
+     * The range must have at least state_size elements. Only the last state_size are used,
+     * and the returned engine will generate the values that follow the last element of the range.
+     */
+    template<class InputIt, class Sentinel = InputIt>
+    [[nodiscard]] static
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    mersenne_twister_engine from_outputs(InputIt first, Sentinel last) noexcept(
+        noexcept(static_cast<bool>(first == last), static_cast<result_type>(*first), static_cast<void>(++first))
+    ) {
+        mersenne_twister_engine result(state_type{});
+        // Used as a circular buffer, so the oldest value is at X[j] after the loop
+        size_t j = 0;
+        for (; !static_cast<bool>(first == last); ++first) {
+            result.X[j] = unscramble(static_cast<result_type>(*first));
+            if (++j == state_size) j = 0;
+        }
+        reverse(result.X + 0, result.X + j);
+        reverse(result.X + j, result.X + state_size);
+        reverse(result.X + 0, result.X + state_size);
+
+        // X now holds the untempered values of the last state_size outputs, which fully determine the next ones
+        result.transition_algorithm();
+        result.i = 0;
+        return result;
+    }
+
 #if __cpp_constexpr >= 201304L
     constexpr
 #endif
@@ -444,6 +601,53 @@ public:
         return first;
     }
 
+    /*
+     * Same as the above, but for a contiguous array of result_type, where the number of values
+     * is known up front. Whole blocks are generated directly into [first, last) (each block being
+     * the transition of the previous one in the destination), and the last one is copied back into X.
+     */
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type* operator()(result_type* first, result_type* last) noexcept {
+        size_t count = static_cast<size_t>(last - first);
+        if (count < state_size - i) {
+            const result_type* x = X + i;
+            i += count;
+            while (first != last) {
+                *first++ = scramble(*x++);
+            }
+            return last;
+        }
+
+        // Rest of the current block
+        for (; i < state_size; ++i) {
+            *first++ = scramble(X[i]);
+        }
+        count = static_cast<size_t>(last - first);
+
+        if (count >= state_size) {
+            const result_type* previous = X;
+            for (; count >= state_size; count -= state_size) {
+                transition_block(previous, first);
+                // The previous block (if it was in the destination) is no longer needed untempered
+                if (previous != X) scramble_block(first - state_size, first);
+                previous = first;
+                first += state_size;
+            }
+            for (size_t j = 0; j < state_size; ++j) {
+                X[j] = previous[j];
+            }
+            scramble_block(first - state_size, first);
+        }
+
+        transition_algorithm();
+        for (i = 0; i < count; ++i) {
+            *first++ = scramble(X[i]);
+        }
+        return last;
+    }
+
     [[nodiscard]]
 #if __cpp_constexpr >= 201304L
     constexpr
@@ -625,6 +829,2132 @@ using mt19937_64 =
                 0xb502'6f5a'a966'19e9u, 29, 0x5555'5555'5555'5555u, 17,
                 0x71d6'7fff'eda6'0000u, 37, 0xfff7'eee0'0000'0000u, 43, 6'364'136'223'846'793'005u>;
 
+/*
+ * The parameters of a mersenne_twister_engine as values, named like the engine's static data members
+ * (e.g., for parameter sets found at runtime by freestanding_mersenne_twister_dynamic_creator.h).
+ */
+template<class UIntType>
+struct mersenne_twister_parameters {
+    using result_type = UIntType;
+
+    size_t word_size;
+    size_t state_size;
+    size_t shift_size;
+    size_t mask_bits;
+    result_type xor_mask;
+    size_t tempering_u;
+    result_type tempering_d;
+    size_t tempering_s;
+    result_type tempering_b;
+    size_t tempering_t;
+    result_type tempering_c;
+    size_t tempering_l;
+    result_type initialization_multiplier;
+
+    template<class Engine>
+    static constexpr mersenne_twister_parameters of() noexcept {
+        return mersenne_twister_parameters{
+            Engine::word_size, Engine::state_size, Engine::shift_size, Engine::mask_bits, Engine::xor_mask,
+            Engine::tempering_u, Engine::tempering_d, Engine::tempering_s, Engine::tempering_b,
+            Engine::tempering_t, Engine::tempering_c, Engine::tempering_l, Engine::initialization_multiplier
+        };
+    }
+
+    friend constexpr bool operator==(const mersenne_twister_parameters& x, const mersenne_twister_parameters& y) noexcept {
+        return x.word_size == y.word_size && x.state_size == y.state_size && x.shift_size == y.shift_size &&
+            x.mask_bits == y.mask_bits && x.xor_mask == y.xor_mask && x.tempering_u == y.tempering_u &&
+            x.tempering_d == y.tempering_d && x.tempering_s == y.tempering_s && x.tempering_b == y.tempering_b &&
+            x.tempering_t == y.tempering_t && x.tempering_c == y.tempering_c && x.tempering_l == y.tempering_l &&
+            x.initialization_multiplier == y.initialization_multiplier;
+    }
+#if __cpp_impl_three_way_comparison < 201907L
+    friend constexpr bool operator!=(const mersenne_twister_parameters& x, const mersenne_twister_parameters& y) noexcept {
+        return !(x == y);
+    }
+#endif
+};
+
+namespace detail {
+
+    // mt19937<UIntType> or mt19937_64<UIntType>, or (if UIntType is too small for them) a
+    // placeholder that is never used
+    template<class UIntType, size_t WordSize, bool Fits = (bits_in_type<UIntType>() >= WordSize)>
+    struct standard_engine {
+        using type = mersenne_twister_engine<UIntType, 3, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0>;
+    };
+    template<class UIntType>
+    struct standard_engine<UIntType, 32u, true> {
+        using type = mt19937<UIntType>;
+    };
+    template<class UIntType>
+    struct standard_engine<UIntType, 64u, true> {
+        using type = mt19937_64<UIntType>;
+    };
+
+}
+
+/*
+ * A Mersenne Twister whose parameters are chosen at runtime, with its state in a buffer of
+ * `parameters.state_size` values provided by the caller (which must outlive the engine).
+ * Generates the same values as `mersenne_twister_engine` with the same parameters.
+ *
+ * When the parameters are those of mt19937 or mt19937_64, the transition and tempering of that
+ * engine are used, so it is about as fast. Otherwise, a loop over the runtime parameters is used.
+ *
+ * Since `min()` and `max()` are not static, this is not a UniformRandomBitGenerator.
+ * It cannot be copied (the buffer would be shared), but it can be copied into another buffer.
+ */
+template<class UIntType = unsigned long long>
+struct dynamic_mersenne_twister_engine {
+    using result_type = UIntType;
+    using parameters_type = mersenne_twister_parameters<result_type>;
+
+    // Whether these parameters are allowed by mersenne_twister_engine
+    static constexpr bool valid(const parameters_type& p) noexcept {
+        return 2u < p.word_size && p.word_size <= detail::bits_in_type<result_type>() && p.state_size != 0u &&
+            0u < p.shift_size && p.shift_size <= p.state_size && p.mask_bits <= p.word_size &&
+            p.tempering_u <= p.word_size && p.tempering_s <= p.word_size && p.tempering_t <= p.word_size && p.tempering_l <= p.word_size &&
+            p.xor_mask <= max_for(p.word_size) && p.tempering_b <= max_for(p.word_size) && p.tempering_c <= max_for(p.word_size) &&
+            p.tempering_d <= max_for(p.word_size) && p.initialization_multiplier <= max_for(p.word_size);
+    }
+
+    // `parameters` must be valid, and `buffer` must have room for `parameters.state_size` values
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    dynamic_mersenne_twister_engine(const parameters_type& parameters, result_type* buffer) noexcept :
+        dynamic_mersenne_twister_engine(parameters, buffer, static_cast<result_type>(5489u & max_for(parameters.word_size))) {}
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    dynamic_mersenne_twister_engine(const parameters_type& parameters, result_type* buffer, result_type value) noexcept :
+        p(parameters), X(buffer), i(0), k(kernel_for(parameters)), max_value(max_for(parameters.word_size)),
+        lower_mask(parameters.mask_bits == 0u ? result_type{0u} : static_cast<result_type>(max_for(parameters.word_size) >> (parameters.word_size - parameters.mask_bits))) {
+        seed(value);
+    }
+    // Copies the parameters and state of `other` into an engine using `buffer`
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    dynamic_mersenne_twister_engine(const dynamic_mersenne_twister_engine& other, result_type* buffer) noexcept :
+        p(other.p), X(buffer), i(other.i), k(other.k), max_value(other.max_value), lower_mask(other.lower_mask) {
+        for (size_t j = 0; j < p.state_size; ++j) {
+            X[j] = other.X[j];
+        }
+    }
+    dynamic_mersenne_twister_engine(const dynamic_mersenne_twister_engine&) = delete;
+    dynamic_mersenne_twister_engine& operator=(const dynamic_mersenne_twister_engine&) = delete;
+
+    [[nodiscard]] constexpr const parameters_type& parameters() const noexcept { return p; }
+    // Whether the transition and tempering of mt19937 or mt19937_64 are used
+    [[nodiscard]] constexpr bool specialized() const noexcept { return k != generic_kernel; }
+    [[nodiscard]] constexpr const result_type* data() const noexcept { return X; }
+    [[nodiscard]] constexpr size_t index() const noexcept { return i; }
+
+    constexpr result_type min() const noexcept { return result_type{0u}; }
+    constexpr result_type max() const noexcept { return max_value; }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void seed(result_type value) noexcept {
+        X[0] = value & max_value;
+        for (size_t j = 1; j < p.state_size; ++j) {
+            X[j] = static_cast<result_type>((1u * p.initialization_multiplier * (X[j-1u] ^ (X[j-1u] >> (p.word_size - 2u))) + j) & max_value);
+        }
+        transition(X, X);
+        i = 0;
+    }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type operator()() noexcept {
+        const result_type z = scramble(X[i]);
+        if (++i == p.state_size) [[unlikely]] {
+            transition(X, X);
+            i = 0;
+        }
+        return z;
+    }
+
+    // The same as mersenne_twister_engine's: whole blocks are generated directly into [first, last)
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type* operator()(result_type* first, result_type* last) noexcept {
+        const size_t n = p.state_size;
+        size_t count = static_cast<size_t>(last - first);
+        if (count < n - i) {
+            scramble_range(X + i, X + i + count, first);
+            i += count;
+            return last;
+        }
+
+        // Rest of the current block
+        first = scramble_range(X + i, X + n, first);
+        count = static_cast<size_t>(last - first);
+
+        if (count >= n) {
+            const result_type* previous = X;
+            for (; count >= n; count -= n) {
+                transition(previous, first);
+                // The previous block (if it was in the destination) is no longer needed untempered
+                if (previous != X) scramble_range(first - n, first, first - n);
+                previous = first;
+                first += n;
+            }
+            for (size_t j = 0; j < n; ++j) {
+                X[j] = previous[j];
+            }
+            scramble_range(first - n, first, first - n);
+        }
+
+        transition(X, X);
+        scramble_range(X, X + count, first);
+        i = count;
+        return last;
+    }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void discard(unsigned long long z) noexcept {
+        while (z >= p.state_size) {
+            transition(X, X);
+            z -= p.state_size;
+        }
+        if (z > (p.state_size - 1u) - i) {
+            transition(X, X);
+            i -= p.state_size;
+        }
+        i += static_cast<size_t>(z);
+    }
+
+    friend
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    bool operator==(const dynamic_mersenne_twister_engine& x, const dynamic_mersenne_twister_engine& y) noexcept {
+        if (!(x.p == y.p) || x.i != y.i) return false;
+        for (size_t j = 0; j < x.p.state_size; ++j) {
+            if (x.X[j] != y.X[j]) return false;
+        }
+        return true;
+    }
+#if __cpp_impl_three_way_comparison < 201907L
+    friend
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    bool operator!=(const dynamic_mersenne_twister_engine& x, const dynamic_mersenne_twister_engine& y) noexcept {
+        return !(x == y);
+    }
+#endif
+
+private:
+    using engine32 = typename detail::standard_engine<result_type, 32u>::type;
+    using engine64 = typename detail::standard_engine<result_type, 64u>::type;
+
+    static constexpr unsigned char generic_kernel = 0u;
+    static constexpr unsigned char mt19937_kernel = 1u;
+    static constexpr unsigned char mt19937_64_kernel = 2u;
+
+    static constexpr result_type max_for(size_t word_size) noexcept {
+        return static_cast<result_type>(~result_type{0u} >> (detail::bits_in_type<result_type>() - word_size));
+    }
+
+    static constexpr unsigned char kernel_for(const parameters_type& parameters) noexcept {
+        return detail::bits_in_type<result_type>() >= 32u && parameters == parameters_type::template of<engine32>() ? mt19937_kernel :
+            detail::bits_in_type<result_type>() >= 64u && parameters == parameters_type::template of<engine64>() ? mt19937_64_kernel :
+            generic_kernel;
+    }
+
+    // Shifts by `amount` (which can be up to word_size), without the bits shifted out of the word
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type rshift(result_type value, size_t amount) const noexcept {
+        return amount >= p.word_size ? result_type{0u} : static_cast<result_type>(value >> amount);
+    }
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type lshift(result_type value, size_t amount) const noexcept {
+        return amount >= p.word_size ? result_type{0u} : static_cast<result_type>(static_cast<result_type>(value << amount) & max_value);
+    }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type scramble(result_type x) const noexcept {
+        if (k == mt19937_kernel) return engine32::scramble(x);
+        if (k == mt19937_64_kernel) return engine64::scramble(x);
+        result_type z = x;
+        z ^= static_cast<result_type>(rshift(z, p.tempering_u) & p.tempering_d);
+        z ^= static_cast<result_type>(lshift(z, p.tempering_s) & p.tempering_b);
+        z ^= static_cast<result_type>(lshift(z, p.tempering_t) & p.tempering_c);
+        z ^= rshift(z, p.tempering_l);
+        return z;
+    }
+
+    // Tempers [first, last) into dest (which may be first), choosing the kernel once for the whole range
+    template<class Engine>
+    static
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type* scramble_range_with(const result_type* first, const result_type* last, result_type* dest) noexcept {
+        for (; first != last; ++first) {
+            *dest++ = Engine::scramble(*first);
+        }
+        return dest;
+    }
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type* scramble_range(const result_type* first, const result_type* last, result_type* dest) const noexcept {
+        if (k == mt19937_kernel) return scramble_range_with<engine32>(first, last, dest);
+        if (k == mt19937_64_kernel) return scramble_range_with<engine64>(first, last, dest);
+        for (; first != last; ++first) {
+            *dest++ = scramble(*first);
+        }
+        return dest;
+    }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type twist(result_type x_i, result_type x_i_plus_1, result_type x_i_plus_m) const noexcept {
+        const result_type Y = static_cast<result_type>((x_i & (max_value ^ lower_mask)) | (x_i_plus_1 & lower_mask));
+        return static_cast<result_type>(x_i_plus_m ^ (Y >> 1u) ^ ((Y & 1u) != 0u ? p.xor_mask : result_type{0u}));
+    }
+
+    // Writes the block following `src` to `dest` (like mersenne_twister_engine::transition_block)
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void transition(const result_type* src, result_type* dest) const noexcept {
+        if (k == mt19937_kernel) return engine32::transition_block(src, dest);
+        if (k == mt19937_64_kernel) return engine64::transition_block(src, dest);
+
+        const size_t n = p.state_size;
+        const size_t m = p.shift_size;
+        if (m == n) {
+            for (size_t j = 0; j < n - 1u; ++j) {
+                dest[j] = twist(src[j], src[j+1u], src[j]);
+            }
+            dest[n - 1u] = twist(src[n - 1u], n == 1u ? src[0] : dest[0], src[n - 1u]);
+            return;
+        }
+        for (size_t j = 0; j < n - m; ++j) {
+            dest[j] = twist(src[j], src[j+1u], src[j + m]);
+        }
+        for (size_t j = n - m; j < n - 1u; ++j) {
+            dest[j] = twist(src[j], src[j+1u], dest[j - (n - m)]);
+        }
+        dest[n - 1u] = twist(src[n - 1u], dest[0], dest[m - 1u]);
+    }
+
+    parameters_type p;
+    result_type* X;
+    size_t i;
+    unsigned char k;
+    result_type max_value;
+    result_type lower_mask;
+};
+
+#if __cpp_inline_variables < 201606L
+template<class UIntType>
+constexpr unsigned char dynamic_mersenne_twister_engine<UIntType>::generic_kernel;
+template<class UIntType>
+constexpr unsigned char dynamic_mersenne_twister_engine<UIntType>::mt19937_kernel;
+template<class UIntType>
+constexpr unsigned char dynamic_mersenne_twister_engine<UIntType>::mt19937_64_kernel;
+#endif
+
+namespace detail {
+
+    // The smallest of unsigned char, unsigned short, unsigned and UIntType with at least `Bits` bits
+    template<size_t Bits, class UIntType>
+    struct lane_type : conditional<(bits_in_type<unsigned char>() >= Bits), unsigned char,
+        typename conditional<(bits_in_type<unsigned short>() >= Bits), unsigned short,
+        typename conditional<(bits_in_type<unsigned>() >= Bits && bits_in_type<unsigned>() < bits_in_type<UIntType>()), unsigned, UIntType>::type>::type> {};
+
+}
+
+/*
+ * The same as mersenne_twister_engine<UIntType, w, ...>, but with the state stored in the smallest unsigned
+ * integer type with w bits (e.g., 1 byte per word when w is 8, instead of sizeof(UIntType)).
+ * The transition and tempering are done on these lanes, and values are returned as UIntType.
+ */
+template<class UIntType, size_t w, size_t n, size_t m, size_t r, UIntType a, size_t u, UIntType d, size_t s, UIntType b, size_t t, UIntType c, size_t l, UIntType f>
+struct packed_mersenne_twister_engine {
+    using result_type = UIntType;
+    using lane_type = typename detail::lane_type<w, result_type>::type;
+    using lane_engine_type = mersenne_twister_engine<lane_type, w, n, m, r, a, u, d, s, b, t, c, l, f>;
+    // The engine with the same parameters and the state stored in `result_type`
+    using engine_type = mersenne_twister_engine<result_type, w, n, m, r, a, u, d, s, b, t, c, l, f>;
+
+    static constexpr size_t word_size = w;
+    static constexpr size_t state_size = n;
+    static constexpr result_type default_seed = engine_type::default_seed;
+
+    static constexpr result_type min() noexcept { return engine_type::min(); }
+    static constexpr result_type max() noexcept { return engine_type::max(); }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    packed_mersenne_twister_engine() noexcept : e() {}
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    explicit packed_mersenne_twister_engine(result_type value) noexcept : e(static_cast<lane_type>(value & max())) {}
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    explicit packed_mersenne_twister_engine(const engine_type& engine) noexcept : e(engine) {}
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void seed(result_type value = default_seed) noexcept {
+        e.seed(static_cast<lane_type>(value & max()));
+    }
+
+    [[nodiscard]] constexpr const lane_engine_type& base() const noexcept { return e; }
+    // The same engine with the state stored in `result_type`
+    [[nodiscard]]
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    engine_type unpack() const noexcept { return engine_type(e); }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type operator()() noexcept { return static_cast<result_type>(e()); }
+
+    // Generates whole blocks of lanes at a time with the lane engine's block path, then widens them
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type* operator()(result_type* first, result_type* last) noexcept {
+        lane_type lanes[state_size]
+#if __cpp_constexpr >= 201907L
+            // No initialisation needed
+#else
+            {}
+#endif
+        ;
+        while (first != last) {
+            const size_t count = static_cast<size_t>(last - first) < state_size ? static_cast<size_t>(last - first) : state_size;
+            e(lanes + 0, lanes + count);
+            for (size_t j = 0; j < count; ++j) {
+                *first++ = static_cast<result_type>(lanes[j]);
+            }
+        }
+        return last;
+    }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void discard(unsigned long long z) noexcept { e.discard(z); }
+
+    friend constexpr bool operator==(const packed_mersenne_twister_engine& x, const packed_mersenne_twister_engine& y) noexcept {
+        return x.e == y.e;
+    }
+#if __cpp_impl_three_way_comparison < 201907L
+    friend constexpr bool operator!=(const packed_mersenne_twister_engine& x, const packed_mersenne_twister_engine& y) noexcept {
+        return !(x.e == y.e);
+    }
+#endif
+
+private:
+    lane_engine_type e;
+};
+
+#if __cpp_inline_variables < 201606L
+template<class UIntType, size_t w, size_t n, size_t m, size_t r, UIntType a, size_t u, UIntType d, size_t s, UIntType b, size_t t, UIntType c, size_t l, UIntType f>
+constexpr size_t packed_mersenne_twister_engine<UIntType, w, n, m, r, a, u, d, s, b, t, c, l, f>::word_size;
+template<class UIntType, size_t w, size_t n, size_t m, size_t r, UIntType a, size_t u, UIntType d, size_t s, UIntType b, size_t t, UIntType c, size_t l, UIntType f>
+constexpr size_t packed_mersenne_twister_engine<UIntType, w, n, m, r, a, u, d, s, b, t, c, l, f>::state_size;
+template<class UIntType, size_t w, size_t n, size_t m, size_t r, UIntType a, size_t u, UIntType d, size_t s, UIntType b, size_t t, UIntType c, size_t l, UIntType f>
+constexpr UIntType packed_mersenne_twister_engine<UIntType, w, n, m, r, a, u, d, s, b, t, c, l, f>::default_seed;
+#endif
+
+/*
+ * A fixed size array of values, as returned by make_random_array.
+ * An aggregate like `std::array`, so that it can be a `constexpr` variable.
+ */
+template<class T, size_t N>
+struct random_array {
+    static_assert(N != 0u, "random_array cannot be empty");
+
+    T values[N];
+
+    static constexpr size_t size() noexcept { return N; }
+    constexpr const T* data() const noexcept { return values; }
+    constexpr const T* begin() const noexcept { return values; }
+    constexpr const T* end() const noexcept { return values + N; }
+    constexpr const T& operator[](size_t j) const noexcept { return values[j]; }
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    T* data() noexcept { return values; }
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    T* begin() noexcept { return values; }
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    T* end() noexcept { return values + N; }
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    T& operator[](size_t j) noexcept { return values[j]; }
+};
+
+/*
+ * The first N values generated by `Engine(seed)`. Meant to be evaluated at compile time
+ * (e.g., `constexpr auto zobrist = make_random_array<781, mt19937_64<>>(1234u);`): the values
+ * are generated a whole block at a time directly into the array, with one transition per block,
+ * which takes far fewer constant evaluation steps than calling `operator()()` N times.
+ */
+template<size_t N, class Engine = mt19937<>>
+#if __cpp_constexpr >= 201304L
+constexpr
+#endif
+random_array<typename Engine::result_type, N> make_random_array(typename Engine::result_type seed = Engine::default_seed) noexcept {
+    random_array<typename Engine::result_type, N> result
+#if __cpp_constexpr < 201907L
+        // (No initialisation needed in C++20)
+        {}
+#endif
+    ;
+    Engine e(seed);
+    e(result.values + 0, result.values + N);
+    return result;
+}
+
+namespace detail {
+
+    // Unrolled by recursion so that compilers merge the byte stores into a single store
+    template<size_t J, size_t Bytes>
+    struct store_byte {
+        template<class UIntType>
+        static
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        void store(UIntType x, unsigned char* dest) noexcept {
+            dest[J] = static_cast<unsigned char>(x >> (8u * J));
+            store_byte<J + 1u, Bytes>::store(x, dest);
+        }
+    };
+    template<size_t Bytes>
+    struct store_byte<Bytes, Bytes> {
+        template<class UIntType>
+        static
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        void store(UIntType, unsigned char*) noexcept {}
+    };
+
+    template<size_t Bytes, class UIntType>
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    unsigned char* store_little_endian(const UIntType* first, const UIntType* last, unsigned char* dest) noexcept {
+        for (; first != last; ++first) {
+            store_byte<0u, Bytes>::store(*first, dest);
+            dest += Bytes;
+        }
+        return dest;
+    }
+
+}
+
+/*
+ * Adapts a mersenne_twister_engine to produce bytes: each value generated by the engine
+ * is split into word_size/8 bytes, least significant byte first. Bytes not used by one call
+ * are kept for the next, so the bytes produced do not depend on how the requests are split up.
+ */
+template<class Engine>
+struct byte_generator {
+    using engine_type = Engine;
+    using result_type = unsigned char;
+
+    static_assert(engine_type::word_size % 8u == 0u, "word_size must be a multiple of 8 to produce bytes");
+    static constexpr size_t bytes_per_word = engine_type::word_size / 8u;
+
+    static constexpr result_type min() noexcept { return result_type{0u}; }
+    static constexpr result_type max() noexcept { return result_type{0xffu}; }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    byte_generator() noexcept : e(), leftover{}, leftover_bytes(0) {}
+    constexpr explicit byte_generator(const engine_type& engine) noexcept : e(engine), leftover{}, leftover_bytes(0) {}
+
+    [[nodiscard]] constexpr const engine_type& base() const noexcept { return e; }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type operator()() noexcept {
+        if (leftover_bytes == 0u) {
+            leftover = e();
+            leftover_bytes = bytes_per_word;
+        }
+        return next_leftover();
+    }
+
+    // Writes `len` bytes starting at `dest`, which does not need to be aligned
+    void generate_bytes(void* dest, size_t len) noexcept {
+        unsigned char* p = static_cast<unsigned char*>(dest);
+        for (; len != 0u && leftover_bytes != 0u; --len) {
+            *p++ = next_leftover();
+        }
+        if (len == 0u) return;
+
+        // Whole words are generated in batches into a local buffer, since the engine's
+        // state could otherwise alias the destination and every byte store would reload it
+        using word_type = typename engine_type::result_type;
+        constexpr size_t batch_size = 64;
+        word_type batch[batch_size];
+        for (size_t words = len / bytes_per_word; words != 0u;) {
+            const size_t count = words < batch_size ? words : batch_size;
+            e(batch + 0, batch + count);
+            p = detail::store_little_endian<bytes_per_word>(batch + 0, batch + count, p);
+            words -= count;
+            len -= count * bytes_per_word;
+        }
+
+        if (len != 0u) {
+            leftover = e();
+            leftover_bytes = bytes_per_word;
+            for (; len != 0u; --len) {
+                *p++ = next_leftover();
+            }
+        }
+    }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void discard(unsigned long long z) noexcept {
+        for (; z != 0u && leftover_bytes != 0u; --z) {
+            static_cast<void>(next_leftover());
+        }
+        e.discard(z / bytes_per_word);
+        for (z %= bytes_per_word; z != 0u; --z) {
+            static_cast<void>(operator()());
+        }
+    }
+
+    friend
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    bool operator==(const byte_generator& x, const byte_generator& y) noexcept {
+        if (x.leftover_bytes != y.leftover_bytes || !(x.e == y.e)) return false;
+        // Only the bytes still to be produced are significant
+        for (size_t j = 0; j < x.leftover_bytes; ++j) {
+            if (static_cast<result_type>(x.leftover >> (8u * j)) != static_cast<result_type>(y.leftover >> (8u * j))) return false;
+        }
+        return true;
+    }
+    friend
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    bool operator!=(const byte_generator& x, const byte_generator& y) noexcept {
+        return !operator==(x, y);
+    }
+
+private:
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type next_leftover() noexcept {
+        result_type byte = static_cast<result_type>(leftover);
+        leftover = static_cast<typename engine_type::result_type>(leftover >> 8u);
+        --leftover_bytes;
+        return byte;
+    }
+
+    engine_type e;
+    typename engine_type::result_type leftover;
+    size_t leftover_bytes;
+};
+
+#if __cpp_inline_variables < 201606L
+template<class Engine>
+constexpr size_t byte_generator<Engine>::bytes_per_word;
+#endif
+
+/*
+ * Serves single bits and small values from the bits of an engine's values, so that e.g. a coin flip uses
+ * one bit of a value instead of a whole one. The bits are those of the values generated by the engine,
+ * least significant bit first, and `next_bits(k)` returns the next `k` of them with the first as its
+ * least significant bit.
+ *
+ * Values are generated `BufferSize` at a time with the engine's block path, so the engine (`base()`)
+ * is ahead of the bits that have been used.
+ */
+template<class Engine, size_t BufferSize = 32u>
+struct bit_pool {
+    using engine_type = Engine;
+    using result_type = typename engine_type::result_type;
+
+    static_assert(BufferSize != 0u, "BufferSize cannot be 0");
+    static constexpr size_t word_size = engine_type::word_size;
+    static constexpr size_t buffer_size = BufferSize;
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    bit_pool() noexcept : e(), buffer{}, next_word(buffer_size), bits(0), bits_left(0) {}
+    constexpr explicit bit_pool(const engine_type& engine) noexcept : e(engine), buffer{}, next_word(buffer_size), bits(0), bits_left(0) {}
+
+    [[nodiscard]] constexpr const engine_type& base() const noexcept { return e; }
+
+    // How many bits can be used before the engine generates more values
+    [[nodiscard]] constexpr size_t bits_available() const noexcept { return bits_left + (buffer_size - next_word) * word_size; }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    bool next_bool() noexcept {
+        if (bits_left == 0u) refill();
+        const bool bit = (bits & 1u) != 0u;
+        bits = static_cast<result_type>(bits >> 1u);
+        --bits_left;
+        return bit;
+    }
+
+    // The next `k` bits (0 < k <= word_size)
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type next_bits(size_t k) noexcept {
+        if (k <= bits_left) return take(k);
+        const size_t have = bits_left;
+        const result_type low = bits;
+        refill();
+        return static_cast<result_type>(low | static_cast<result_type>(take(k - have) << have));
+    }
+
+    // A value uniformly distributed in [0, bound) (bound != 0), using as many bits as `bound - 1` has
+    // for each try. A try is rejected less than half of the time.
+    // `bound` can be larger than max() + 1 (when result_type is wider than the engine's words), in which case
+    // each try is made of the next bits of more than one value.
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type next_below(result_type bound) noexcept {
+        size_t k = 0;
+        for (result_type largest = static_cast<result_type>(bound - 1u); largest != 0u; largest = static_cast<result_type>(largest >> 1u)) {
+            ++k;
+        }
+        if (k == 0u) return result_type{0u};
+        for (;;) {
+            result_type x = 0;
+            for (size_t have = 0; have < k; have += word_size) {
+                const size_t n = k - have < word_size ? k - have : word_size;
+                x = static_cast<result_type>(x | static_cast<result_type>(next_bits(n) << have));
+            }
+            if (x < bound) return x;
+        }
+    }
+
+private:
+    // Takes the lowest k bits of `bits` (0 < k <= bits_left)
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type take(size_t k) noexcept {
+        const result_type x = static_cast<result_type>(bits & (engine_type::max() >> (word_size - k)));
+        // Shifting by k - 1 then 1, since k can be the number of bits in result_type
+        bits = static_cast<result_type>(static_cast<result_type>(bits >> (k - 1u)) >> 1u);
+        bits_left -= k;
+        return x;
+    }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void refill() noexcept {
+        if (next_word == buffer_size) {
+            e(buffer + 0, buffer + buffer_size);
+            next_word = 0;
+        }
+        bits = buffer[next_word++];
+        bits_left = word_size;
+    }
+
+    engine_type e;
+    result_type buffer[buffer_size];
+    size_t next_word;
+    result_type bits;
+    size_t bits_left;
+};
+
+#if __cpp_inline_variables < 201606L
+template<class Engine, size_t BufferSize>
+constexpr size_t bit_pool<Engine, BufferSize>::word_size;
+template<class Engine, size_t BufferSize>
+constexpr size_t bit_pool<Engine, BufferSize>::buffer_size;
+#endif
+
+/*
+ * An engine seeded with a single value that does the work of seeding as values are needed: word k of the
+ * first block only depends on words k, k + 1 and k + shift_size of the initial state, so the initial state
+ * is computed as far as those and then only word k is transitioned. Generating a few values after seeding
+ * costs about shift_size steps of initialisation instead of state_size steps of initialisation and transition.
+ *
+ * Generates exactly the same values as `Engine(value)`. Once the whole first block has been used (or
+ * `discard` goes past what has been computed), it is the same as `Engine`.
+ */
+template<class Engine>
+struct lazy_seed_engine {
+    using engine_type = Engine;
+    using result_type = typename engine_type::result_type;
+
+    static constexpr size_t state_size = engine_type::state_size;
+    static constexpr result_type default_seed = engine_type::default_seed;
+
+    static constexpr result_type min() noexcept { return engine_type::min(); }
+    static constexpr result_type max() noexcept { return engine_type::max(); }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    lazy_seed_engine() noexcept : lazy_seed_engine(default_seed) {}
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    explicit lazy_seed_engine(result_type value) noexcept : e(typename engine_type::state_type{}), initialised(0), transitioned(0) {
+        seed(value);
+    }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void seed(result_type value = default_seed) noexcept {
+        e.X[0] = value & max();
+        e.i = 0;
+        initialised = 1;
+        transitioned = 0;
+    }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    result_type operator()() noexcept {
+        if (transitioned != state_size) {
+            if (e.i == transitioned) transition_next();
+            if (transitioned != state_size) return engine_type::scramble(e.X[e.i++]);
+        }
+        return e();
+    }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void discard(unsigned long long z) noexcept {
+        if (transitioned != state_size) {
+            if (z < transitioned - e.i) {
+                e.i += static_cast<size_t>(z);
+                return;
+            }
+            complete();
+        }
+        e.discard(z);
+    }
+
+    // Finishes seeding, and returns the engine (which is then the same as *this)
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    engine_type& complete() noexcept {
+        while (transitioned != state_size) {
+            transition_next();
+        }
+        return e;
+    }
+
+    friend
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    bool operator==(const lazy_seed_engine& x, const lazy_seed_engine& y) noexcept {
+        lazy_seed_engine x_copy = x;
+        lazy_seed_engine y_copy = y;
+        return x_copy.complete() == y_copy.complete();
+    }
+#if __cpp_impl_three_way_comparison < 201907L
+    friend
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    bool operator!=(const lazy_seed_engine& x, const lazy_seed_engine& y) noexcept {
+        return !(x == y);
+    }
+#endif
+
+private:
+    // Transitions word `transitioned` of the first block in place, the same as transition_block(X, X) does
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void transition_next() noexcept {
+        const size_t k = transitioned;
+        const size_t last_needed = k + engine_type::shift_size < state_size ? k + engine_type::shift_size : state_size - 1u;
+        for (; initialised <= last_needed; ++initialised) {
+            e.X[initialised] = engine_type::initialization_step(e.X[initialised - 1u], initialised);
+        }
+        // (Past the end, X[k + 1] and X[k + shift_size] wrap around to words that were already transitioned)
+        e.X[k] = engine_type::twist(e.X[k], e.X[k + 1u < state_size ? k + 1u : 0u], e.X[(k + engine_type::shift_size) % state_size]);
+        ++transitioned;
+    }
+
+    engine_type e;
+    // X[0, initialised) has been initialised, and X[0, transitioned) has also been transitioned
+    size_t initialised;
+    size_t transitioned;
+};
+
+#if __cpp_inline_variables < 201606L
+template<class Engine>
+constexpr size_t lazy_seed_engine<Engine>::state_size;
+template<class Engine>
+constexpr typename lazy_seed_engine<Engine>::result_type lazy_seed_engine<Engine>::default_seed;
+#endif
+
+/*
+ * An endless input range over the values generated by an engine, one block at a time.
+ * Each element is a contiguous range of tempered values: first the rest of the engine's
+ * current block, then `state_size` values at a time. The engine is advanced by a whole block
+ * when that block is reached (by begin() or ++), whether or not its values are looked at.
+ *
+ * Works with the standard library's ranges (e.g., `block_view(e) | std::views::take(k)`)
+ * without needing anything from it: the iterator and sentinel satisfy `std::input_iterator`
+ * and `std::sentinel_for` as they are.
+ */
+template<class Engine>
+struct block_view {
+    using engine_type = Engine;
+    using result_type = typename engine_type::result_type;
+
+    struct block {
+        const result_type* first;
+        const result_type* last;
+
+        constexpr const result_type* begin() const noexcept { return first; }
+        constexpr const result_type* end() const noexcept { return last; }
+        constexpr const result_type* data() const noexcept { return first; }
+        constexpr size_t size() const noexcept { return static_cast<size_t>(last - first); }
+        constexpr const result_type& operator[](size_t j) const noexcept { return first[j]; }
+    };
+
+    struct sentinel {};
+
+    struct iterator {
+        using value_type = block;
+        using difference_type = ptrdiff_t;
+
+        constexpr iterator() noexcept : parent(nullptr) {}
+        constexpr explicit iterator(block_view& view) noexcept : parent(&view) {}
+
+        constexpr block operator*() const noexcept { return parent->current(); }
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        iterator& operator++() noexcept {
+            parent->next();
+            return *this;
+        }
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        void operator++(int) noexcept { parent->next(); }
+
+        friend constexpr bool operator==(const iterator&, sentinel) noexcept { return false; }
+#if __cpp_impl_three_way_comparison < 201907L
+        friend constexpr bool operator==(sentinel, const iterator&) noexcept { return false; }
+        friend constexpr bool operator!=(const iterator&, sentinel) noexcept { return true; }
+        friend constexpr bool operator!=(sentinel, const iterator&) noexcept { return true; }
+#endif
+
+    private:
+        block_view* parent;
+    };
+
+    constexpr explicit block_view(engine_type& engine) noexcept : e(&engine),
+#if __cpp_constexpr < 201907L
+        // (No initialisation needed in C++20)
+        buffer{},
+#endif
+        count(0) {}
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    iterator begin() noexcept {
+        // (A copy of a view that has started continues from the same block)
+        if (count == 0u) next();
+        return iterator(*this);
+    }
+    constexpr sentinel end() const noexcept { return sentinel{}; }
+
+private:
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void next() noexcept {
+        count = engine_type::state_size - e->i;
+        (*e)(buffer + 0, buffer + count);
+    }
+
+    constexpr block current() const noexcept { return block{ buffer + 0, buffer + count }; }
+
+    template<class>
+    friend struct value_view;
+
+    // The current block is buffer[0, count). It is not stored as pointers, so that copying or
+    // moving the view does not leave them pointing into the original.
+    engine_type* e;
+    result_type buffer[engine_type::state_size];
+    size_t count;
+};
+
+/*
+ * An endless input range over the values generated by an engine, taken from a block_view.
+ * Incrementing is a pointer increment except at the end of each block.
+ */
+template<class Engine>
+struct value_view {
+    using engine_type = Engine;
+    using result_type = typename engine_type::result_type;
+
+    struct sentinel {};
+
+    struct iterator {
+        using value_type = result_type;
+        using difference_type = ptrdiff_t;
+
+        constexpr iterator() noexcept : parent(nullptr) {}
+        constexpr explicit iterator(value_view& view) noexcept : parent(&view) {}
+
+        constexpr result_type operator*() const noexcept { return parent->blocks.buffer[parent->position]; }
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        iterator& operator++() noexcept {
+            parent->next();
+            return *this;
+        }
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        void operator++(int) noexcept { parent->next(); }
+
+        friend constexpr bool operator==(const iterator&, sentinel) noexcept { return false; }
+#if __cpp_impl_three_way_comparison < 201907L
+        friend constexpr bool operator==(sentinel, const iterator&) noexcept { return false; }
+        friend constexpr bool operator!=(const iterator&, sentinel) noexcept { return true; }
+        friend constexpr bool operator!=(sentinel, const iterator&) noexcept { return true; }
+#endif
+
+    private:
+        value_view* parent;
+    };
+
+    constexpr explicit value_view(engine_type& engine) noexcept : blocks(engine), position(0) {}
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    iterator begin() noexcept {
+        // (A copy of a view that has started continues from the same value)
+        if (blocks.count == 0u) refill();
+        return iterator(*this);
+    }
+    constexpr sentinel end() const noexcept { return sentinel{}; }
+
+private:
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void refill() noexcept {
+        blocks.next();
+        position = 0;
+    }
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void next() noexcept {
+        if (++position == blocks.count) refill();
+    }
+
+    // The current value is blocks.buffer[position] (an index, like block_view's, so copies stay valid)
+    block_view<engine_type> blocks;
+    size_t position;
+};
+
+namespace detail {
+
+    using random_word = unsigned long long;
+#if __cpp_inline_variables >= 201606L
+    inline
+#endif
+    constexpr size_t random_word_bits = 64u;
+#if __cpp_inline_variables >= 201606L
+    inline
+#endif
+    constexpr random_word random_word_mask = 0xffff'ffff'ffff'ffffu;
+
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128;
+#endif
+
+    // The high and low 64 bits of the 128 bit product x * y
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void mul_wide(random_word x, random_word y, random_word& hi, random_word& lo) noexcept {
+#if defined(__SIZEOF_INT128__)
+        const uint128 product = static_cast<uint128>(x) * y;
+        hi = static_cast<random_word>(product >> 64u);
+        lo = static_cast<random_word>(product);
+#else
+        const random_word x_lo = x & 0xffff'ffffu;
+        const random_word x_hi = x >> 32u;
+        const random_word y_lo = y & 0xffff'ffffu;
+        const random_word y_hi = y >> 32u;
+        const random_word lo_lo = x_lo * y_lo;
+        const random_word hi_lo = x_hi * y_lo;
+        const random_word cross = (lo_lo >> 32u) + (hi_lo & 0xffff'ffffu) + x_lo * y_hi;
+        hi = x_hi * y_hi + (hi_lo >> 32u) + (cross >> 32u);
+        lo = ((cross << 32u) | (lo_lo & 0xffff'ffffu)) & random_word_mask;
+#endif
+    }
+
+    template<class T>
+    void prefetch_for_write(const T& x) noexcept {
+#if defined(__GNUC__)
+        __builtin_prefetch(__builtin_addressof(x), 1);
+#else
+        static_cast<void>(x);
+#endif
+    }
+
+    namespace swap_adl {
+        // Only used when no better swap is found by argument dependent lookup
+        // (the trailing pack makes this less specialised than any `swap(T&, T&)`)
+        template<class T, class... Unused>
+        void swap(T& x, T& y, Unused...) noexcept(noexcept(T(static_cast<T&&>(x))) && noexcept(x = static_cast<T&&>(y))) {
+            T tmp(static_cast<T&&>(x));
+            x = static_cast<T&&>(y);
+            y = static_cast<T&&>(tmp);
+        }
+
+        template<class ForwardIt>
+        void iter_swap(ForwardIt x, ForwardIt y) {
+            swap(*x, *y);
+        }
+    }
+
+    /*
+     * Uniform draws from [0, bound) for sequences of consecutive bounds, taken from 64 bit words made
+     * of whole blocks of the engine's output.
+     *
+     * A single 64 bit word is shared by as many draws as fit (Lemire's multiply-shift method applied
+     * to each bound in turn, with the low half of one product feeding the next), and the division to
+     * compute the rejection threshold is only needed when the final low half is smaller than
+     * the product of the bounds.
+     */
+    template<class Engine>
+    struct bounded_draws {
+        using engine_type = Engine;
+        using result_type = typename engine_type::result_type;
+
+        static constexpr size_t max_batch = 8u;
+        static constexpr size_t values_per_word = (random_word_bits + engine_type::word_size - 1u) / engine_type::word_size;
+
+        // `expected_draws` limits how far the engine is advanced ahead of what is used
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        bounded_draws(engine_type& engine, unsigned long long expected_draws) noexcept : e(&engine),
+            wanted(expected_draws < ~0ull / values_per_word ? expected_draws * values_per_word : ~0ull),
+#if __cpp_constexpr < 201907L
+            // (No initialisation needed in C++20)
+            buffer{},
+#endif
+            position(0), available(0) {}
+
+        // Draws from [0, bound), [0, bound - 1), ... (or [0, bound + 1), ... if `ascending`) into `out`,
+        // as many as share one word and at most `limit`. Returns the number of draws.
+        // Every bound must be at least 1.
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        size_t batch(random_word bound, bool ascending, size_t limit, random_word* out) noexcept {
+            const random_word largest = !ascending ? bound : bound < random_word_mask - (max_batch - 1u) ? bound + (max_batch - 1u) : random_word_mask;
+            size_t k = batch_size(largest);
+            if (limit < k) k = limit;
+            random_word bounds[max_batch]
+#if __cpp_constexpr < 201907L
+                {}
+#endif
+            ;
+            random_word product = 1u;
+            for (size_t j = 0; j < k; ++j) {
+                bounds[j] = ascending ? bound + j : bound - j;
+                product *= bounds[j];
+            }
+            for (;;) {
+                random_word low = next_word();
+                for (size_t j = 0; j < k; ++j) {
+                    mul_wide(low, bounds[j], out[j], low);
+                }
+                if (low >= product || low >= ((random_word_mask - product) + 1u) % product) return k;
+            }
+        }
+
+        // A single draw from [0, bound)
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        random_word operator()(random_word bound) noexcept {
+            random_word draw = 0;
+            batch(bound, false, 1u, &draw);
+            return draw;
+        }
+
+        // A uniformly distributed word, from `values_per_word` of the engine's values
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        random_word next_word() noexcept {
+            constexpr size_t shift = values_per_word == 1u ? 0u : engine_type::word_size;
+            random_word word = 0;
+            for (size_t j = 0; j < values_per_word; ++j) {
+                if (position == available) refill();
+                word = (word << shift) | static_cast<random_word>(buffer[position++]);
+            }
+            return word & random_word_mask;
+        }
+
+    private:
+        // How many bounds no larger than `largest` have a product that fits in a word
+        static constexpr size_t batch_size(random_word largest) noexcept {
+            return largest < (1ull << 8u) ? 8u :
+                largest < (1ull << 9u) ? 7u :
+                largest < (1ull << 10u) ? 6u :
+                largest < (1ull << 12u) ? 5u :
+                largest < (1ull << 16u) ? 4u :
+                largest < (1ull << 21u) ? 3u :
+                largest < (1ull << 32u) ? 2u : 1u;
+        }
+
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        void refill() noexcept {
+            // The rest of the engine's current block, unless fewer values are expected to be needed
+            size_t count = engine_type::state_size - e->i;
+            if (wanted < count) count = wanted == 0u ? 1u : static_cast<size_t>(wanted);
+            wanted = wanted < count ? 0u : wanted - count;
+            (*e)(buffer + 0, buffer + count);
+            position = 0;
+            available = count;
+        }
+
+        engine_type* e;
+        unsigned long long wanted;
+        result_type buffer[engine_type::state_size];
+        size_t position;
+        size_t available;
+    };
+
+}
+
+/*
+ * Shuffles [first, last) with the Fisher-Yates algorithm, drawing the swap positions in batches
+ * (see detail::bounded_draws) some way ahead of the swaps, and prefetching them when drawn.
+ * The permutation only depends on the state of the engine. The engine is advanced past every value
+ * used, and possibly up to the end of its current block.
+ */
+template<class RandomIt, class Engine>
+void shuffle(RandomIt first, RandomIt last, Engine& e) {
+    using detail::swap_adl::iter_swap;
+    using size_type = unsigned long long;
+    constexpr size_t max_batch = detail::bounded_draws<Engine>::max_batch;
+    // How many swap positions are drawn ahead (a power of two)
+    constexpr size_t window = 64u;
+    if (last - first < 2) return;
+    const size_type n = static_cast<size_type>(last - first);
+    detail::bounded_draws<Engine> draw(e, n - 1u);
+    detail::random_word batch[max_batch];
+    detail::random_word targets[window];
+    // The `k`th swap exchanges element `n - 1 - k` with a uniformly chosen element in [0, n - 1 - k]
+    size_type drawn = 0;
+    for (size_type swapped = 0; swapped != n - 1u; ++swapped) {
+        while (drawn != n - 1u && drawn - swapped <= window - max_batch) {
+            const size_type remaining = n - 1u - drawn;
+            const size_t k = draw.batch(n - drawn, false, static_cast<size_t>(remaining < max_batch ? remaining : max_batch), batch);
+            for (size_t j = 0; j < k; ++j) {
+                detail::prefetch_for_write(first[static_cast<ptrdiff_t>(batch[j])]);
+                targets[(drawn + j) % window] = batch[j];
+            }
+            drawn += k;
+        }
+        iter_swap(first + static_cast<ptrdiff_t>(n - 1u - swapped), first + static_cast<ptrdiff_t>(targets[swapped % window]));
+    }
+}
+
+/*
+ * Selection sampling (Knuth's Algorithm S): copies `count` (or all, if there are fewer) elements
+ * of [first, last) chosen uniformly to `out`, in the order they appear in. Only needs forward iterators.
+ * Returns the end of the output.
+ */
+template<class ForwardIt, class OutputIt, class Engine>
+OutputIt sample_selection(ForwardIt first, ForwardIt last, OutputIt out, unsigned long long count, Engine& e) {
+    unsigned long long remaining = 0;
+    for (ForwardIt it = first; it != last; ++it) ++remaining;
+    unsigned long long needed = count < remaining ? count : remaining;
+    detail::bounded_draws<Engine> draw(e, remaining);
+    constexpr size_t max_batch = detail::bounded_draws<Engine>::max_batch;
+    detail::random_word draws[max_batch];
+    // The current element is chosen with probability needed / remaining
+    while (needed != 0u && needed != remaining) {
+        const size_t k = draw.batch(remaining, false, static_cast<size_t>(remaining < max_batch ? remaining : max_batch), draws);
+        for (size_t j = 0; j < k && needed != 0u; ++j, ++first, --remaining) {
+            if (draws[j] < needed) {
+                *out = *first;
+                ++out;
+                --needed;
+            }
+        }
+    }
+    for (; needed != 0u; --needed, ++first) {
+        *out = *first;
+        ++out;
+    }
+    return out;
+}
+
+/*
+ * Reservoir sampling (Algorithm R): chooses `count` (or all, if there are fewer) elements of [first, last)
+ * uniformly, in a single pass that only needs input iterators. The sample is stored in `out`,
+ * which must have room for `count` elements, in no particular order. Returns the end of the sample.
+ */
+template<class InputIt, class RandomIt, class Engine>
+RandomIt sample_reservoir(InputIt first, InputIt last, RandomIt out, unsigned long long count, Engine& e) {
+    unsigned long long seen = 0;
+    for (; seen < count && first != last; ++first, ++seen) {
+        out[static_cast<ptrdiff_t>(seen)] = *first;
+    }
+    if (first == last) return out + static_cast<ptrdiff_t>(seen);
+    detail::bounded_draws<Engine> draw(e, count);
+    constexpr size_t max_batch = detail::bounded_draws<Engine>::max_batch;
+    detail::random_word draws[max_batch];
+    // The element after the `seen`th replaces a uniformly chosen one with probability count / (seen + 1)
+    // (The length of the input is unknown, so the draws left in the final batch are wasted)
+    while (first != last) {
+        const size_t k = draw.batch(seen + 1u, true, max_batch, draws);
+        for (size_t j = 0; j < k && first != last; ++j, ++first, ++seen) {
+            if (draws[j] < count) {
+                out[static_cast<ptrdiff_t>(draws[j])] = *first;
+            }
+        }
+    }
+    return out + static_cast<ptrdiff_t>(count);
+}
+
+/*
+ * Chooses `k` (or `n`, if that is smaller) distinct integers uniformly from [0, n) and writes them to
+ * `out` in increasing order. Returns the end of the output.
+ *
+ * When `k` is small compared to `n`, uses Floyd's algorithm (with `out` as the set of chosen integers,
+ * so it takes O(k**2) time), otherwise selection sampling (O(n) time).
+ */
+template<class RandomIt, class Engine>
+RandomIt choose_k(unsigned long long n, unsigned long long k, RandomIt out, Engine& e) {
+    if (k > n) k = n;
+    if (k == 0u) return out;
+    constexpr size_t max_batch = detail::bounded_draws<Engine>::max_batch;
+    detail::random_word draws[max_batch];
+    if (k > n / k) {
+        detail::bounded_draws<Engine> draw(e, n);
+        unsigned long long remaining = n;
+        unsigned long long needed = k;
+        for (unsigned long long x = 0; needed != 0u;) {
+            if (needed == remaining) {
+                for (; needed != 0u; --needed, ++x) *out++ = x;
+                break;
+            }
+            const size_t batch = draw.batch(remaining, false, static_cast<size_t>(remaining < max_batch ? remaining : max_batch), draws);
+            for (size_t j = 0; j < batch && needed != 0u; ++j, ++x, --remaining) {
+                if (draws[j] < needed) {
+                    *out++ = x;
+                    --needed;
+                }
+            }
+        }
+        return out;
+    }
+
+    detail::bounded_draws<Engine> draw(e, k);
+    // Floyd: for each j in [n - k, n), choose t in [0, j] and add t, or j if t was already chosen.
+    // out[0, size) is kept sorted, and j is always larger than everything chosen before it.
+    unsigned long long size = 0;
+    for (unsigned long long j = n - k; j != n;) {
+        const unsigned long long limit = n - j;
+        const size_t batch = draw.batch(j + 1u, true, static_cast<size_t>(limit < max_batch ? limit : max_batch), draws);
+        for (size_t d = 0; d < batch; ++d, ++j) {
+            const unsigned long long t = draws[d];
+            unsigned long long lo = 0;
+            unsigned long long hi = size;
+            while (lo != hi) {
+                const unsigned long long mid = lo + (hi - lo) / 2u;
+                if (out[static_cast<ptrdiff_t>(mid)] < t) lo = mid + 1u;
+                else hi = mid;
+            }
+            if (lo != size && out[static_cast<ptrdiff_t>(lo)] == t) {
+                out[static_cast<ptrdiff_t>(size)] = j;
+            } else {
+                for (unsigned long long p = size; p != lo; --p) {
+                    out[static_cast<ptrdiff_t>(p)] = out[static_cast<ptrdiff_t>(p - 1u)];
+                }
+                out[static_cast<ptrdiff_t>(lo)] = t;
+            }
+            ++size;
+        }
+    }
+    return out + static_cast<ptrdiff_t>(size);
+}
+
+/*
+ * Samples from [0, N) with probabilities proportional to integer weights in O(1) time per sample,
+ * with Vose's alias method: each index j has a threshold and an alias, and a sample picks j uniformly
+ * and keeps it with probability threshold / 2**64, otherwise returns its alias.
+ *
+ * Both choices are made with one 64 bit word (one value of a 64 bit engine): the high half of
+ * `word * N` is j and the low half is compared to the threshold.
+ *
+ * At least one weight must be nonzero, and N times the sum of the weights must be less than 2**64.
+ * The probabilities are exact up to about N / 2**64.
+ */
+template<size_t N>
+struct alias_table {
+    static_assert(N != 0u, "alias_table cannot be empty");
+
+    struct entry {
+        unsigned long long threshold;
+        size_t alias;
+    };
+
+    // Reads N weights starting at `weights` (e.g., an array of N integers)
+    template<class InputIt>
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    explicit alias_table(InputIt weights) : table{} {
+        unsigned long long total = 0;
+        for (size_t j = 0; j < N; ++j, ++weights) {
+            table[j].threshold = static_cast<unsigned long long>(*weights);
+            table[j].alias = N;
+            total += table[j].threshold;
+        }
+        // Index j is "small" if N * weight < total and "large" otherwise. Each small index is
+        // paired with a large one, which gives the small one the rest of its 1/N share.
+        // Unpaired indices have alias N, so the table itself holds the lists of both.
+        for (size_t j = 0; j < N; ++j) {
+            table[j].threshold *= N;
+        }
+        size_t large = next_unpaired(0u, total, true);
+        size_t small = next_unpaired(0u, total, false);
+        for (size_t current = small; current != N && large != N;) {
+            table[current].alias = large;
+            table[large].threshold -= total - table[current].threshold;
+            table[current].threshold = fraction(table[current].threshold, total);
+            if (table[large].threshold < total) {
+                const size_t became_small = large;
+                large = next_unpaired(large + 1u, total, true);
+                // (If it is after `small`, it will be found when looking for the next small index)
+                if (became_small < small) {
+                    current = became_small;
+                    continue;
+                }
+            }
+            small = next_unpaired(small + 1u, total, false);
+            current = small;
+        }
+        // What is left has exactly its share
+        for (size_t j = 0; j < N; ++j) {
+            if (table[j].alias == N) {
+                table[j].threshold = ~0ull;
+                table[j].alias = j;
+            }
+        }
+    }
+
+    static constexpr size_t size() noexcept { return N; }
+    constexpr const entry& operator[](size_t j) const noexcept { return table[j]; }
+
+    // The sample given by a uniformly distributed 64 bit word
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    size_t lookup(unsigned long long word) const noexcept {
+        detail::random_word index = 0;
+        detail::random_word low = 0;
+        detail::mul_wide(word & detail::random_word_mask, N, index, low);
+        return low < table[index].threshold ? static_cast<size_t>(index) : table[index].alias;
+    }
+
+    template<class Engine>
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    size_t operator()(Engine& e) const noexcept {
+        // The same word as detail::bounded_draws<Engine>::next_word(), without its buffer
+        constexpr size_t values_per_word = detail::bounded_draws<Engine>::values_per_word;
+        constexpr size_t shift = values_per_word == 1u ? 0u : Engine::word_size;
+        detail::random_word word = 0;
+        for (size_t j = 0; j < values_per_word; ++j) {
+            word = (word << shift) | static_cast<detail::random_word>(e());
+        }
+        return lookup(word);
+    }
+
+    // Writes samples to [first, last), generating the engine's values in bulk.
+    // Uses the same values of the engine as calling operator() for each sample.
+    template<class Engine, class ForwardIt>
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void sample(Engine& e, ForwardIt first, ForwardIt last) const {
+        unsigned long long count = 0;
+        for (ForwardIt it = first; it != last; ++it) {
+            ++count;
+        }
+        detail::bounded_draws<Engine> draw(e, count);
+        for (; first != last; ++first) {
+            *first = lookup(draw.next_word());
+        }
+    }
+
+private:
+    // The first index from `from` that is not paired yet and is large (or small)
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    size_t next_unpaired(size_t from, unsigned long long total, bool large) const noexcept {
+        for (; from < N; ++from) {
+            if (table[from].alias == N && (table[from].threshold >= total) == large) return from;
+        }
+        return N;
+    }
+
+    // floor(2**64 * numerator / denominator), for numerator < denominator
+    static
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    unsigned long long fraction(unsigned long long numerator, unsigned long long denominator) noexcept {
+        unsigned long long result = 0;
+        for (size_t bit = 0; bit < detail::random_word_bits; ++bit) {
+            // Doubling the remainder without overflowing
+            const bool one = numerator >= denominator - numerator;
+            result = (result << 1u) | (one ? 1u : 0u);
+            numerator = one ? numerator - (denominator - numerator) : numerator + numerator;
+        }
+        return result;
+    }
+
+    entry table[N];
+};
+
+namespace detail {
+
+    // Polynomials over GF(2), as arrays of words with 64 coefficients each (lowest degree first)
+    namespace gf2 {
+        using word = unsigned long long;
+#if __cpp_inline_variables >= 201606L
+        inline
+#endif
+        constexpr size_t word_bits = 64u;
+#if __cpp_inline_variables >= 201606L
+        inline
+#endif
+        constexpr word word_mask = 0xffff'ffff'ffff'ffffu;
+
+        constexpr bool coefficient(const word* p, size_t k) noexcept {
+            return ((p[k / word_bits] >> (k % word_bits)) & 1u) != 0u;
+        }
+
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        void set_coefficient(word* p, size_t k) noexcept {
+            p[k / word_bits] |= word{1u} << (k % word_bits);
+        }
+
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        bool parity(word x) noexcept {
+            for (size_t shift = word_bits / 2u; shift != 0u; shift /= 2u) {
+                x ^= x >> shift;
+            }
+            return (x & 1u) != 0u;
+        }
+
+        // 64 coefficients of `p` starting at `k` (`p` must have a word after the one containing `k`)
+        constexpr word coefficients_at(const word* p, size_t k) noexcept {
+            return (k % word_bits == 0u) ? p[k / word_bits] :
+                (((p[k / word_bits] >> (k % word_bits)) | (p[k / word_bits + 1u] << (word_bits - k % word_bits))) & word_mask);
+        }
+
+        // `p += q * x^shift`, ignoring any coefficients past the `p_words` words of `p`
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        void add_shifted(word* p, size_t p_words, const word* q, size_t q_words, size_t shift) noexcept {
+            const size_t offset = shift / word_bits;
+            const size_t bits = shift % word_bits;
+            for (size_t j = 0; j < q_words && offset + j < p_words; ++j) {
+                p[offset + j] ^= (q[j] << bits) & word_mask;
+                if (bits != 0u && offset + j + 1u < p_words) {
+                    p[offset + j + 1u] ^= q[j] >> (word_bits - bits);
+                }
+            }
+        }
+
+        // Spreads the low 32 bits of x to the even bits (so the square of a polynomial can be taken a word at a time)
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        word spread(word x) noexcept {
+            x &= 0xffff'ffffu;
+            x = (x | (x << 16u)) & 0x0000'ffff'0000'ffffu;
+            x = (x | (x << 8u)) & 0x00ff'00ff'00ff'00ffu;
+            x = (x | (x << 4u)) & 0x0f0f'0f0f'0f0f'0f0fu;
+            x = (x | (x << 2u)) & 0x3333'3333'3333'3333u;
+            x = (x | (x << 1u)) & 0x5555'5555'5555'5555u;
+            return x;
+        }
+
+        // Polynomial arithmetic modulo a polynomial `modulus` of degree `Degree`
+        template<size_t Degree>
+        struct modular {
+            static constexpr size_t words = Degree / word_bits + 1u;
+
+            // p = p * p mod modulus
+            static
+#if __cpp_constexpr >= 201304L
+            constexpr
+#endif
+            void square(word* p, const word* modulus) noexcept {
+                word product[2u * words]
+#if __cpp_constexpr >= 201907L
+                    // No initialisation needed
+#else
+                    {}
+#endif
+                ;
+                for (size_t j = 0; j < words; ++j) {
+                    product[2u * j] = spread(p[j]);
+                    product[2u * j + 1u] = spread(p[j] >> 32u);
+                }
+                reduce(product, modulus);
+                for (size_t j = 0; j < words; ++j) {
+                    p[j] = product[j];
+                }
+            }
+
+            // Reduces a product of two polynomials of degree < Degree
+            static
+#if __cpp_constexpr >= 201304L
+            constexpr
+#endif
+            void reduce(word* product, const word* modulus) noexcept {
+                for (size_t k = 2u * Degree - 1u; k-- > Degree;) {
+                    if (product[k / word_bits] == 0u) {
+                        // Skip to the top of the next word
+                        k -= k % word_bits;
+                        continue;
+                    }
+                    if (!coefficient(product, k)) continue;
+                    const size_t offset = (k - Degree) / word_bits;
+                    const size_t bits = (k - Degree) % word_bits;
+                    if (bits == 0u) {
+                        for (size_t j = 0; j < words; ++j) {
+                            product[offset + j] ^= modulus[j];
+                        }
+                    } else {
+                        for (size_t j = 0; j < words; ++j) {
+                            product[offset + j] ^= (modulus[j] << bits) & word_mask;
+                            product[offset + j + 1u] ^= modulus[j] >> (word_bits - bits);
+                        }
+                    }
+                }
+            }
+
+            // The minimal polynomial of a sequence s[0], ..., s[sequence_length - 1] (with s[k] stored as coefficient
+            // `sequence_length - 1 - k` of `reversed`, which needs a spare word at the end), found with the
+            // Berlekamp-Massey algorithm. Coefficients past Degree are dropped. Returns its degree.
+            static
+#if __cpp_constexpr >= 201304L
+            constexpr
+#endif
+            size_t minimal_polynomial(const word* reversed, size_t sequence_length, word* result) noexcept {
+                // Connection polynomial C and the previous one B
+                word C[words + 1u]
+#if __cpp_constexpr >= 201907L
+                    // No initialisation needed
+#else
+                    {}
+#endif
+                ;
+                word B[words + 1u]
+#if __cpp_constexpr >= 201907L
+                    // No initialisation needed
+#else
+                    {}
+#endif
+                ;
+                word T[words + 1u]
+#if __cpp_constexpr >= 201907L
+                    // No initialisation needed
+#else
+                    {}
+#endif
+                ;
+                for (size_t j = 0; j < words + 1u; ++j) {
+                    C[j] = B[j] = 0u;
+                }
+                C[0] = B[0] = 1u;
+                size_t L = 0;
+                size_t shift = 1;
+                for (size_t k = 0; k < sequence_length; ++k) {
+                    word discrepancy = 0u;
+                    for (size_t j = 0; j <= L / word_bits; ++j) {
+                        discrepancy ^= C[j] & coefficients_at(reversed, sequence_length - 1u - k + j * word_bits);
+                    }
+                    if (!parity(discrepancy)) {
+                        ++shift;
+                    } else if (2u * L <= k) {
+                        for (size_t j = 0; j < words + 1u; ++j) T[j] = C[j];
+                        add_shifted(C, words + 1u, B, words + 1u, shift);
+                        L = k + 1u - L;
+                        for (size_t j = 0; j < words + 1u; ++j) B[j] = T[j];
+                        shift = 1;
+                    } else {
+                        add_shifted(C, words + 1u, B, words + 1u, shift);
+                        ++shift;
+                    }
+                }
+
+                // The minimal polynomial is the reciprocal of C: x**L * C(1/x)
+                for (size_t j = 0; j < words; ++j) {
+                    result[j] = 0u;
+                }
+                for (size_t k = 0; k <= L && k <= Degree; ++k) {
+                    if (coefficient(C, L - k)) {
+                        set_coefficient(result, k);
+                    }
+                }
+                return L;
+            }
+
+            // p = p * x mod modulus
+            static
+#if __cpp_constexpr >= 201304L
+            constexpr
+#endif
+            void multiply_by_x(word* p, const word* modulus) noexcept {
+                for (size_t j = words; j-- > 1u;) {
+                    p[j] = ((p[j] << 1u) | (p[j - 1u] >> (word_bits - 1u))) & word_mask;
+                }
+                p[0] = (p[0] << 1u) & word_mask;
+                if (coefficient(p, Degree)) {
+                    for (size_t j = 0; j < words; ++j) {
+                        p[j] ^= modulus[j];
+                    }
+                }
+            }
+
+            // p = p * x**-1 mod modulus (the constant term of modulus must be 1)
+            static
+#if __cpp_constexpr >= 201304L
+            constexpr
+#endif
+            void divide_by_x(word* p, const word* modulus) noexcept {
+                if ((p[0] & 1u) != 0u) {
+                    for (size_t j = 0; j < words; ++j) {
+                        p[j] ^= modulus[j];
+                    }
+                }
+                for (size_t j = 0; j + 1u < words; ++j) {
+                    p[j] = (p[j] >> 1u) | ((p[j + 1u] << (word_bits - 1u)) & word_mask);
+                }
+                p[words - 1u] >>= 1u;
+            }
+        };
+
+    }
+
+}
+
+/*
+ * Advances an engine by `distance * 2**exponent` steps (the same as `discard(distance * 2**exponent)`),
+ * in time that does not depend on the distance once constructed.
+ * Constructing it computes the characteristic polynomial of the engine's recurrence and
+ * `x**(distance * 2**exponent)` modulo that, taking `O(log(distance * 2**exponent) * degree**2)` time.
+ * apply() then takes `O(degree * state_size)` time.
+ *
+ * This requires that the engine's parameters give it the maximal period of `2**degree - 1`
+ * (like mt19937 and mt19937_64), and that the state of the engine it is applied to was
+ * produced by the engine (e.g., by seeding) rather than written directly.
+ */
+template<class Engine>
+struct mersenne_twister_jump {
+    using engine_type = Engine;
+    using result_type = typename engine_type::result_type;
+
+    static constexpr size_t degree = engine_type::state_size * engine_type::word_size - engine_type::mask_bits;
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    explicit mersenne_twister_jump(unsigned long long distance, size_t exponent = 0) noexcept : polynomial{}, remainder(0) {
+        detail::gf2::word modulus[words]
+#if __cpp_constexpr >= 201907L
+            // No initialisation needed
+#else
+            {}
+#endif
+        ;
+        characteristic_polynomial(modulus);
+
+        // x**(distance * 2**exponent), by squaring and multiplying
+        polynomial[0] = 1u;
+        for (size_t bit = detail::bits_in_type<unsigned long long>(); bit-- > 0u;) {
+            modular::square(polynomial, modulus);
+            if ((distance >> bit) & 1u) {
+                modular::multiply_by_x(polynomial, modulus);
+            }
+        }
+        for (size_t j = 0; j < exponent; ++j) {
+            modular::square(polynomial, modulus);
+        }
+
+        // apply() jumps by a whole number of blocks and then moves the index,
+        // so that the result is equal to the engine after discard()
+        constexpr size_t n = engine_type::state_size;
+        size_t power_of_two = 1u % n;
+        for (size_t j = 0; j < exponent; ++j) {
+            power_of_two = (2u * power_of_two) % n;
+        }
+        remainder = static_cast<size_t>((distance % n) * power_of_two % n);
+        for (size_t j = 0; j < remainder; ++j) {
+            modular::divide_by_x(polynomial, modulus);
+        }
+    }
+
+    // e.discard(distance * 2**exponent)
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void apply(engine_type& e) const noexcept {
+        constexpr size_t n = engine_type::state_size;
+        constexpr size_t m = engine_type::shift_size;
+        // The next n words of the sequence are `sum(polynomial[k] * (the n words starting at k))`, evaluated
+        // with Horner's method. Each step of the recurrence is done in a circular buffer.
+        result_type result[n]
+#if __cpp_constexpr >= 201907L
+            // No initialisation needed
+#else
+            {}
+#endif
+        ;
+        for (size_t j = 0; j < n; ++j) {
+            result[j] = engine_type::min();
+        }
+        size_t start = 0;
+        for (size_t k = degree; k-- > 0u;) {
+            const size_t next = start + 1u == n ? 0u : start + 1u;
+            const size_t plus_m = start + m >= n ? start + m - n : start + m;
+            result[start] = engine_type::twist(result[start], result[next], result[plus_m]);
+            start = next;
+
+            if (detail::gf2::coefficient(polynomial, k)) {
+                for (size_t j = 0; j < n - start; ++j) {
+                    result[start + j] ^= e.X[j];
+                }
+                for (size_t j = n - start; j < n; ++j) {
+                    result[j - (n - start)] ^= e.X[j];
+                }
+            }
+        }
+
+        for (size_t j = 0; j < n - start; ++j) {
+            e.X[j] = result[start + j];
+        }
+        for (size_t j = n - start; j < n; ++j) {
+            e.X[j] = result[j - (n - start)];
+        }
+
+        e.discard(remainder);
+    }
+
+private:
+    static constexpr size_t words = detail::gf2::modular<degree>::words;
+    using modular = detail::gf2::modular<degree>;
+
+    // The minimal polynomial of one bit of the untempered output, found with the Berlekamp-Massey algorithm.
+    // With a maximal period, this is the characteristic polynomial of the recurrence.
+    static
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void characteristic_polynomial(detail::gf2::word* result) noexcept {
+        using detail::gf2::word;
+        using detail::gf2::word_bits;
+        constexpr size_t sequence_length = 2u * degree;
+        constexpr size_t sequence_words = sequence_length / word_bits + 2u;
+
+        // s[k] is stored at `sequence_length - 1 - k`, so the window s[k], s[k-1], ... is in increasing order
+        word reversed[sequence_words]
+#if __cpp_constexpr >= 201907L
+            // No initialisation needed
+#else
+            {}
+#endif
+        ;
+        for (size_t j = 0; j < sequence_words; ++j) {
+            reversed[j] = 0u;
+        }
+        engine_type e;
+        for (size_t k = 0; k < sequence_length; ++k) {
+            if (k != 0u && k % engine_type::state_size == 0u) {
+                e.transition_algorithm();
+            }
+            if ((e.X[k % engine_type::state_size] & 1u) != 0u) {
+                detail::gf2::set_coefficient(reversed, sequence_length - 1u - k);
+            }
+        }
+
+        modular::minimal_polynomial(reversed, sequence_length, result);
+    }
+
+    // x**(distance * 2**exponent - remainder) mod the characteristic polynomial
+    detail::gf2::word polynomial[words];
+    // (distance * 2**exponent) % state_size
+    size_t remainder;
+};
+
+/*
+ * A compact description of an engine state: `Engine(seed)` advanced to the start of stream `stream`
+ * (`stream * 2**StreamExponent` values, the same substreams as thread_engine_registry), then by
+ * `offset` more values. The engine can be recreated from these 24 bytes anywhere (e.g., sent to
+ * another process instead of the whole state), with seeding, a jump and a discard.
+ * Like `Engine(seed)`, only the low `word_size` bits of `seed` are used, and descriptors whose seeds only
+ * differ in the other bits compare equal and serialise the same.
+ */
+template<class Engine, size_t StreamExponent = 64u>
+struct stream_descriptor {
+    using engine_type = Engine;
+    static constexpr size_t stream_exponent = StreamExponent;
+    // Size of the serialised form: seed, stream and offset as 64 bit little endian integers
+    static constexpr size_t size_in_bytes = 24u;
+
+    unsigned long long seed;
+    unsigned long long stream;
+    unsigned long long offset;
+
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    engine_type engine() const noexcept {
+        engine_type e(static_cast<typename engine_type::result_type>(seed));
+        if (stream != 0u) mersenne_twister_jump<engine_type>(stream, stream_exponent).apply(e);
+        e.discard(offset);
+        return e;
+    }
+
+    // Writes size_in_bytes bytes to `dest`
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    unsigned char* to_bytes(unsigned char* dest) const noexcept {
+        const unsigned long long fields[3] = { used_seed(seed), stream, offset };
+        for (unsigned long long field : fields) {
+            for (size_t j = 0; j < 8u; ++j) {
+                *dest++ = static_cast<unsigned char>(field >> (8u * j));
+            }
+        }
+        return dest;
+    }
+
+    // Reads size_in_bytes bytes written by to_bytes
+    static
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    stream_descriptor from_bytes(const unsigned char* src) noexcept {
+        unsigned long long fields[3] = { 0u, 0u, 0u };
+        for (unsigned long long& field : fields) {
+            for (size_t j = 0; j < 8u; ++j) {
+                field |= static_cast<unsigned long long>(*src++) << (8u * j);
+            }
+        }
+        return stream_descriptor{ used_seed(fields[0]), fields[1], fields[2] };
+    }
+
+    friend constexpr bool operator==(const stream_descriptor& x, const stream_descriptor& y) noexcept {
+        return used_seed(x.seed) == used_seed(y.seed) && x.stream == y.stream && x.offset == y.offset;
+    }
+#if __cpp_impl_three_way_comparison < 201907L
+    friend constexpr bool operator!=(const stream_descriptor& x, const stream_descriptor& y) noexcept {
+        return !(x == y);
+    }
+#endif
+
+private:
+    // The bits of `seed` that the engine is seeded with (all of them if word_size >= 64)
+    static constexpr unsigned long long used_seed(unsigned long long seed) noexcept {
+        return seed & static_cast<unsigned long long>(engine_type::max());
+    }
+};
+
+/*
+ * N engines, each starting on its own `Alignment` byte boundary (a cache line by default) and padded to a
+ * multiple of it, so that engines used by different threads never share a cache line. (A plain array of
+ * engines puts the index `i` of one engine, which is written on every call, next to the start of the state
+ * of the next one.) The layout of each engine is unchanged.
+ *
+ * Objects with this alignment are only guaranteed to be allocated correctly by `new` since C++17.
+ */
+template<class Engine, size_t N, size_t Alignment = FREESTANDING_MERSENNE_TWISTER_CACHE_LINE_SIZE>
+struct engine_array {
+    using engine_type = Engine;
+    using result_type = typename engine_type::result_type;
+
+    static_assert(N != 0u, "engine_array cannot be empty");
+    static_assert(Alignment != 0u && (Alignment & (Alignment - 1u)) == 0u, "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(engine_type), "Alignment must be at least the alignment of the engine");
+
+    static constexpr size_t alignment = Alignment;
+
+    struct alignas(Alignment) slot {
+        engine_type engine;
+    };
+
+    struct iterator {
+        using value_type = engine_type;
+        using difference_type = ptrdiff_t;
+
+        slot* current;
+
+        constexpr engine_type& operator*() const noexcept { return current->engine; }
+        constexpr engine_type* operator->() const noexcept { return &current->engine; }
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        iterator& operator++() noexcept {
+            ++current;
+            return *this;
+        }
+#if __cpp_constexpr >= 201304L
+        constexpr
+#endif
+        iterator operator++(int) noexcept {
+            iterator copy = *this;
+            ++current;
+            return copy;
+        }
+
+        friend constexpr bool operator==(const iterator& x, const iterator& y) noexcept { return x.current == y.current; }
+#if __cpp_impl_three_way_comparison < 201907L
+        friend constexpr bool operator!=(const iterator& x, const iterator& y) noexcept { return x.current != y.current; }
+#endif
+    };
+
+    slot slots[N];
+
+    static constexpr size_t size() noexcept { return N; }
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    engine_type& operator[](size_t j) noexcept { return slots[j].engine; }
+    constexpr const engine_type& operator[](size_t j) const noexcept { return slots[j].engine; }
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    iterator begin() noexcept { return iterator{ slots + 0 }; }
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    iterator end() noexcept { return iterator{ slots + N }; }
+
+    // Engine j becomes `master` advanced by `stride` j times (e.g., `mersenne_twister_jump<Engine>(1, 64)`
+    // gives the same substreams as thread_engine_registry)
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    void assign_substreams(const engine_type& master, const mersenne_twister_jump<engine_type>& stride) noexcept {
+        slots[0].engine = master;
+        for (size_t j = 1; j < N; ++j) {
+            slots[j].engine = slots[j - 1u].engine;
+            stride.apply(slots[j].engine);
+        }
+    }
+};
+
+#if __cpp_inline_variables < 201606L
+template<class Engine, size_t N, size_t Alignment>
+constexpr size_t engine_array<Engine, N, Alignment>::alignment;
+template<class Engine, size_t StreamExponent>
+constexpr size_t stream_descriptor<Engine, StreamExponent>::stream_exponent;
+template<class Engine, size_t StreamExponent>
+constexpr size_t stream_descriptor<Engine, StreamExponent>::size_in_bytes;
+template<class Engine>
+constexpr size_t mersenne_twister_jump<Engine>::degree;
+template<class Engine>
+constexpr size_t mersenne_twister_jump<Engine>::words;
+template<size_t Degree>
+constexpr size_t detail::gf2::modular<Degree>::words;
+template<class Engine>
+constexpr size_t detail::bounded_draws<Engine>::max_batch;
+template<class Engine>
+constexpr size_t detail::bounded_draws<Engine>::values_per_word;
+#endif
+
+#ifdef FREESTANDING_MERSENNE_TWISTER_EXTERN_TEMPLATES
+// Explicitly instantiated by src/freestanding_mersenne_twister.cpp (the freestanding_mersenne_twister_instantiations
+// library), so that every translation unit using mt19937<> or mt19937_64<> does not have to instantiate them
+extern template struct mersenne_twister_state<detail::uint_least32_t, 624>;
+extern template struct mersenne_twister_engine<detail::uint_least32_t, 32, 624, 397, 31,
+        0x9908'b0dfu, 11, 0xffff'ffffu, 7, 0x9d2c'5680u, 15, 0xefc6'0000u, 18, 1'812'433'253u>;
+extern template struct mersenne_twister_state<detail::uint_least64_t, 312>;
+extern template struct mersenne_twister_engine<detail::uint_least64_t, 64, 312, 156, 31,
+        0xb502'6f5a'a966'19e9u, 29, 0x5555'5555'5555'5555u, 17,
+        0x71d6'7fff'eda6'0000u, 37, 0xfff7'eee0'0000'0000u, 43, 6'364'136'223'846'793'005u>;
+#endif
+
 #ifdef FREESTANDING_MERSENNE_TWISTER_SELF_TEST
 #if __cpp_constexpr >= 201304L
 static_assert(mt19937<>{}.peek(10000) == 4123659995u, "Did not pass self test");
@@ -0,0 +1,214 @@
+#ifndef FREESTANDING_MERSENNE_TWISTER_DYNAMIC_CREATOR_H
+#define FREESTANDING_MERSENNE_TWISTER_DYNAMIC_CREATOR_H 1'01
+
+// Optional companion to freestanding_mersenne_twister.h: searches for Mersenne Twister parameter sets,
+// like Matsumoto and Nishimura's Dynamic Creator. Like the main header, this depends on nothing else.
+
+#include "freestanding_mersenne_twister.h"
+
+namespace freestanding_mersenne_twister {
+
+namespace detail {
+
+    // Whether 2**p - 1 is prime (for p up to 44497)
+    constexpr bool is_mersenne_exponent(size_t p) noexcept {
+        return p == 2u || p == 3u || p == 5u || p == 7u || p == 13u || p == 17u || p == 19u || p == 31u ||
+            p == 61u || p == 89u || p == 107u || p == 127u || p == 521u || p == 607u || p == 1279u ||
+            p == 2203u || p == 2281u || p == 3217u || p == 4253u || p == 4423u || p == 9689u || p == 9941u ||
+            p == 11213u || p == 19937u || p == 21701u || p == 23209u || p == 44497u;
+    }
+
+    // A tempering shift of mt19937 (for 32 bits) scaled to another word size
+    constexpr size_t scaled_tempering_shift(size_t word_size, size_t shift) noexcept {
+        return word_size * shift / 32u == 0u ? 1u : word_size * shift / 32u;
+    }
+
+}
+
+/*
+ * Finds parameter sets for mersenne_twister_engine with word size `WordSize` and period `2**Exponent - 1`
+ * (`Exponent` must be a Mersenne exponent, e.g. 521, 607, 1279, 2203 or 19937), each with its own
+ * characteristic polynomial, for giving many generators independent streams.
+ *
+ * state_size and mask_bits are the smallest that give the period, and shift_size is state_size / 2.
+ * Each id gets its own xor_mask: the low id_bits bits are the id and the rest are searched for
+ * (with the most significant bit set) until the recurrence has the maximal period.
+ * The tempering shifts are those of mt19937 (scaled to the word size) or mt19937_64, and the tempering
+ * masks b and c are chosen at random (Dynamic Creator instead searches for masks that give the best
+ * equidistribution, which is not done here).
+ *
+ * Testing each candidate takes `O(Exponent**3 / 64)` time, and about `Exponent` candidates are needed
+ * on average, so large exponents are slow to search for (seconds for 521, hours for 19937).
+ */
+template<class UIntType, size_t WordSize, size_t Exponent>
+struct dynamic_creator {
+    using result_type = UIntType;
+    using parameters_type = mersenne_twister_parameters<result_type>;
+
+    static_assert(detail::is_mersenne_exponent(Exponent), "Exponent must be a Mersenne exponent");
+    static_assert(WordSize >= 4u && WordSize <= detail::bits_in_type<result_type>(), "WordSize must fit in UIntType");
+
+    static constexpr size_t word_size = WordSize;
+    static constexpr size_t exponent = Exponent;
+    static constexpr size_t state_size = (Exponent + WordSize - 1u) / WordSize;
+    static constexpr size_t shift_size = state_size / 2u;
+    static constexpr size_t mask_bits = state_size * WordSize - Exponent;
+    static constexpr size_t id_bits = WordSize / 2u < 16u ? WordSize / 2u : 16u;
+
+    static_assert(state_size >= 2u, "Exponent must be larger than WordSize");
+
+    // Whether the recurrence with this xor_mask (and this class's other parameters) has the maximal period
+    static
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    bool has_maximal_period(result_type xor_mask) noexcept {
+        using detail::gf2::word;
+        using detail::gf2::word_bits;
+        using modular = detail::gf2::modular<Exponent>;
+        constexpr size_t sequence_length = 2u * Exponent;
+        constexpr size_t sequence_words = sequence_length / word_bits + 2u;
+        constexpr result_type lower_mask = static_cast<result_type>((result_type{1u} << mask_bits) - 1u);
+        constexpr result_type upper_mask = static_cast<result_type>(result_mask & ~lower_mask);
+
+        // Any state except zero will do: this is the engine's initialisation from its default seed
+        result_type X[state_size]
+#if __cpp_constexpr >= 201907L
+            // No initialisation needed
+#else
+            {}
+#endif
+        ;
+        X[0] = static_cast<result_type>(5489u & result_mask);
+        for (size_t j = 1; j < state_size; ++j) {
+            X[j] = static_cast<result_type>((1u * initialization_multiplier() * (X[j - 1u] ^ (X[j - 1u] >> (word_size - 2u))) + j) & result_mask);
+        }
+
+        // Bit 0 of the words after the initial state, stored reversed for modular::minimal_polynomial
+        word reversed[sequence_words]
+#if __cpp_constexpr >= 201907L
+            // No initialisation needed
+#else
+            {}
+#endif
+        ;
+        for (size_t j = 0; j < sequence_words; ++j) {
+            reversed[j] = 0u;
+        }
+        for (size_t k = 0; k < state_size + sequence_length; ++k) {
+            const size_t j = k % state_size;
+            const result_type y = static_cast<result_type>((X[j] & upper_mask) | (X[(j + 1u) % state_size] & lower_mask));
+            X[j] = static_cast<result_type>(X[(j + shift_size) % state_size] ^ (y >> 1u) ^ ((y & 1u) ? xor_mask : result_type{0u}));
+            if (k >= state_size && (X[j] & 1u) != 0u) {
+                detail::gf2::set_coefficient(reversed, sequence_length - 1u - (k - state_size));
+            }
+        }
+
+        word polynomial[modular::words]
+#if __cpp_constexpr >= 201907L
+            // No initialisation needed
+#else
+            {}
+#endif
+        ;
+        if (modular::minimal_polynomial(reversed, sequence_length, polynomial) != Exponent) return false;
+
+        // Since 2**Exponent - 1 is prime, the polynomial is primitive if x**(2**Exponent) == x modulo it
+        word power[modular::words]
+#if __cpp_constexpr >= 201907L
+            // No initialisation needed
+#else
+            {}
+#endif
+        ;
+        for (size_t j = 0; j < modular::words; ++j) {
+            power[j] = 0u;
+        }
+        power[0] = 2u;
+        for (size_t j = 0; j < Exponent; ++j) {
+            modular::square(power, polynomial);
+        }
+        for (size_t j = 1; j < modular::words; ++j) {
+            if (power[j] != 0u) return false;
+        }
+        return power[0] == 2u;
+    }
+
+    // Searches for a parameter set for `id` (which must be less than 2**id_bits), trying at most `max_tries`
+    // xor_masks. Different ids give different parameter sets, and the same `id` and `seed` give the same one.
+    // Returns false if none was found.
+    static
+#if __cpp_constexpr >= 201304L
+    constexpr
+#endif
+    bool create(unsigned long long id, unsigned long long seed, parameters_type& result, unsigned long long max_tries = ~0ull) noexcept {
+        if ((id >> id_bits) != 0u) return false;
+        mt19937_64<unsigned long long> g(seed ^ (id * 0x9e37'79b9'7f4a'7c15u));
+        constexpr result_type top_bit = static_cast<result_type>(result_type{1u} << (word_size - 1u));
+        for (; max_tries != 0u; --max_tries) {
+            const result_type xor_mask = static_cast<result_type>((static_cast<result_type>(g() << id_bits) | id | top_bit) & result_mask);
+            if (has_maximal_period(xor_mask)) {
+                result = parameters(xor_mask, static_cast<result_type>(g()), static_cast<result_type>(g()));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // This class's parameters with the given xor_mask and random bits for the tempering masks
+    static constexpr parameters_type parameters(result_type xor_mask, result_type b_bits, result_type c_bits) noexcept {
+        return parameters_type{
+            word_size, state_size, shift_size, mask_bits, xor_mask,
+            tempering_u, tempering_d, tempering_s, static_cast<result_type>(b_bits & result_mask & (result_mask << tempering_s)),
+            tempering_t, static_cast<result_type>(c_bits & result_mask & (result_mask << tempering_t)),
+            tempering_l, initialization_multiplier()
+        };
+    }
+
+private:
+    static constexpr result_type result_mask = static_cast<result_type>(~result_type{0u} >> (detail::bits_in_type<result_type>() - word_size));
+
+    static constexpr bool is_64 = word_size == 64u;
+    static constexpr size_t tempering_u = is_64 ? 29u : detail::scaled_tempering_shift(word_size, 11u);
+    static constexpr result_type tempering_d = static_cast<result_type>(is_64 ? 0x5555'5555'5555'5555u & result_mask : result_mask);
+    static constexpr size_t tempering_s = is_64 ? 17u : detail::scaled_tempering_shift(word_size, 7u);
+    static constexpr size_t tempering_t = is_64 ? 37u : detail::scaled_tempering_shift(word_size, 15u);
+    static constexpr size_t tempering_l = is_64 ? 43u : detail::scaled_tempering_shift(word_size, 18u);
+
+    static constexpr result_type initialization_multiplier() noexcept {
+        return static_cast<result_type>((is_64 ? 6'364'136'223'846'793'005u : 1'812'433'253u) & result_mask);
+    }
+};
+
+#if __cpp_inline_variables < 201606L
+template<class UIntType, size_t WordSize, size_t Exponent>
+constexpr size_t dynamic_creator<UIntType, WordSize, Exponent>::word_size;
+template<class UIntType, size_t WordSize, size_t Exponent>
+constexpr size_t dynamic_creator<UIntType, WordSize, Exponent>::exponent;
+template<class UIntType, size_t WordSize, size_t Exponent>
+constexpr size_t dynamic_creator<UIntType, WordSize, Exponent>::state_size;
+template<class UIntType, size_t WordSize, size_t Exponent>
+constexpr size_t dynamic_creator<UIntType, WordSize, Exponent>::shift_size;
+template<class UIntType, size_t WordSize, size_t Exponent>
+constexpr size_t dynamic_creator<UIntType, WordSize, Exponent>::mask_bits;
+template<class UIntType, size_t WordSize, size_t Exponent>
+constexpr size_t dynamic_creator<UIntType, WordSize, Exponent>::id_bits;
+template<class UIntType, size_t WordSize, size_t Exponent>
+constexpr UIntType dynamic_creator<UIntType, WordSize, Exponent>::result_mask;
+template<class UIntType, size_t WordSize, size_t Exponent>
+constexpr bool dynamic_creator<UIntType, WordSize, Exponent>::is_64;
+template<class UIntType, size_t WordSize, size_t Exponent>
+constexpr size_t dynamic_creator<UIntType, WordSize, Exponent>::tempering_u;
+template<class UIntType, size_t WordSize, size_t Exponent>
+constexpr UIntType dynamic_creator<UIntType, WordSize, Exponent>::tempering_d;
+template<class UIntType, size_t WordSize, size_t Exponent>
+constexpr size_t dynamic_creator<UIntType, WordSize, Exponent>::tempering_s;
+template<class UIntType, size_t WordSize, size_t Exponent>
+constexpr size_t dynamic_creator<UIntType, WordSize, Exponent>::tempering_t;
+template<class UIntType, size_t WordSize, size_t Exponent>
+constexpr size_t dynamic_creator<UIntType, WordSize, Exponent>::tempering_l;
+#endif
+
+}
+
+#endif
@@ -0,0 +1,450 @@
+#ifndef FREESTANDING_MERSENNE_TWISTER_THREADS_H
+#define FREESTANDING_MERSENNE_TWISTER_THREADS_H 1'01
+
+// Optional companion to freestanding_mersenne_twister.h for hosted multi-threaded programs.
+// Unlike the main header, this depends on the standard library.
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "freestanding_mersenne_twister.h"
+
+namespace freestanding_mersenne_twister {
+
+/*
+ * Gives each thread its own engine, each on a separate substream of one master engine:
+ * substream k is the master engine advanced by `k * 2**SubstreamExponent` values.
+ * Threads are given substreams in the order they first call local() (or choose one with bind()).
+ *
+ * local() only takes a lock the first time it is called by each thread (and the first time after seed()),
+ * so drawing from the returned engine never contends with other threads.
+ * `Tag` can be used to have multiple independent registries with the same engine type.
+ */
+template<class Engine, size_t SubstreamExponent = 64u, class Tag = void>
+struct thread_engine_registry {
+    using engine_type = Engine;
+    using result_type = typename engine_type::result_type;
+    static constexpr size_t substream_exponent = SubstreamExponent;
+
+    thread_engine_registry() = delete;
+
+    // The calling thread's engine
+    static engine_type& local() {
+        slot& s = this_thread_slot();
+        registry_state& shared = state();
+        if (s.generation != shared.generation.load(std::memory_order_acquire)) [[unlikely]] {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            s.engine = shared.at(shared.next_index++);
+            s.generation = shared.generation.load(std::memory_order_relaxed);
+        }
+        return s.engine;
+    }
+
+    // Makes the calling thread use substream `index` from the start (instead of the next unused one)
+    static engine_type& bind(unsigned long long index) {
+        slot& s = this_thread_slot();
+        registry_state& shared = state();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        s.engine = shared.at(index);
+        s.generation = shared.generation.load(std::memory_order_relaxed);
+        return s.engine;
+    }
+
+    // A copy of the start of substream `index`
+    static engine_type substream(unsigned long long index) {
+        registry_state& shared = state();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        return shared.at(index);
+    }
+
+    // Resets the registry with a new master engine. Every thread (including the ones that already
+    // have an engine) gets a new substream the next time it calls local().
+    static void seed(const engine_type& master) {
+        registry_state& shared = state();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.master = master;
+        shared.cursor = master;
+        shared.cursor_index = 0;
+        shared.next_index = 0;
+        shared.generation.fetch_add(1u, std::memory_order_release);
+    }
+    static void seed(result_type value = engine_type::default_seed) {
+        seed(engine_type(value));
+    }
+
+private:
+    struct slot {
+        engine_type engine;
+        unsigned long long generation = ~0ull;
+    };
+
+    struct registry_state {
+        std::mutex mutex;
+        std::atomic<unsigned long long> generation{0u};
+        engine_type master;
+        // The last substream handed out, so that handing out the next only takes one jump
+        engine_type cursor;
+        unsigned long long cursor_index = 0;
+        unsigned long long next_index = 0;
+
+        // Must hold the mutex
+        engine_type at(unsigned long long index) {
+            if (index < cursor_index) {
+                cursor = master;
+                cursor_index = 0;
+            }
+            for (; cursor_index < index; ++cursor_index) {
+                substream_jump().apply(cursor);
+            }
+            return cursor;
+        }
+    };
+
+    static registry_state& state() {
+        static registry_state shared;
+        return shared;
+    }
+
+    static slot& this_thread_slot() {
+        thread_local slot s;
+        return s;
+    }
+
+    static const mersenne_twister_jump<engine_type>& substream_jump() {
+        static const mersenne_twister_jump<engine_type> jump(1u, substream_exponent);
+        return jump;
+    }
+};
+
+/*
+ * One sequence shared between threads, where the values each thread gets do not depend on scheduling.
+ * The sequence is split into blocks of block_size values: block k is always values
+ * [k * block_size, (k+1) * block_size) of the starting engine.
+ *
+ * Each thread draws through its own handle, which claims the next unused run of RunBlocks consecutive
+ * blocks with a single atomic increment and generates them locally. Since a handle's claims only
+ * increase, it gets from the end of its previous run to the start of the next one (over the runs the
+ * other handles claimed in between) with cached jumps over 2**i runs, so the cost of skipping does not
+ * grow with the number of blocks skipped. Jumps that cover fewer than jump_threshold blocks are done
+ * with transitions instead.
+ */
+template<class Engine, unsigned long long RunBlocks = 65'536u>
+struct shared_block_engine {
+    using engine_type = Engine;
+    using result_type = typename engine_type::result_type;
+    static constexpr size_t block_size = engine_type::state_size;
+    static constexpr unsigned long long run_blocks = RunBlocks;
+    // Applying a mersenne_twister_jump costs about as much as discarding this many blocks
+    // (measured with mt19937 and mt19937_64; a jump is a few milliseconds)
+    static constexpr unsigned long long jump_threshold = 4'096u;
+
+    static_assert(RunBlocks != 0u, "RunBlocks cannot be 0");
+
+    explicit shared_block_engine(const engine_type& start) noexcept : start(start), next_run(0u) {}
+    explicit shared_block_engine(result_type value = engine_type::default_seed) noexcept : shared_block_engine(engine_type(value)) {}
+
+    shared_block_engine(const shared_block_engine&) = delete;
+    shared_block_engine& operator=(const shared_block_engine&) = delete;
+
+    // Index of the first block of a run of run_blocks blocks that have not been claimed before
+    unsigned long long claim() noexcept {
+        return next_run.fetch_add(1u, std::memory_order_relaxed) * run_blocks;
+    }
+
+    [[nodiscard]] const engine_type& initial_engine() const noexcept { return start; }
+
+    // A per-thread view of the shared sequence. Not thread-safe itself.
+    struct handle {
+        using result_type = typename engine_type::result_type;
+
+        explicit handle(shared_block_engine& shared) noexcept :
+            shared(&shared), cursor(shared.start), cursor_block(0u), run_end(0u), current_block(0u), position(block_size) {}
+
+        static constexpr result_type min() noexcept { return engine_type::min(); }
+        static constexpr result_type max() noexcept { return engine_type::max(); }
+
+        result_type operator()() noexcept {
+            if (position == block_size) [[unlikely]] {
+                refill();
+            }
+            return values[position++];
+        }
+
+        // Index of the block that the last value came from
+        [[nodiscard]] unsigned long long block() const noexcept { return current_block; }
+
+    private:
+        void refill() noexcept {
+            if (cursor_block == run_end) {
+                const unsigned long long first = shared->claim();
+                skip_runs((first - cursor_block) / run_blocks);
+                cursor_block = first;
+                run_end = first + run_blocks;
+            }
+            current_block = cursor_block++;
+            cursor(values + 0, values + block_size);
+            position = 0;
+        }
+
+        // Advances cursor by `runs * run_blocks` blocks
+        void skip_runs(unsigned long long runs) noexcept {
+            for (size_t i = 0; runs != 0u; ++i, runs >>= 1u) {
+                if ((runs & 1u) == 0u) continue;
+                if ((1ull << i) >= (jump_threshold + run_blocks - 1u) / run_blocks) {
+                    run_jump(i).apply(cursor);
+                } else {
+                    for (unsigned long long k = 0; k < (run_blocks << i); ++k) {
+                        cursor.discard(block_size);
+                    }
+                }
+            }
+        }
+
+        shared_block_engine* shared;
+        // At the start of block cursor_block, which is in the claimed run ending at run_end
+        engine_type cursor;
+        unsigned long long cursor_block;
+        unsigned long long run_end;
+        unsigned long long current_block;
+        size_t position;
+        result_type values[block_size];
+    };
+
+private:
+    static constexpr size_t max_run_bits = detail::bits_in_type<unsigned long long>();
+
+    // The jump over 2**i runs, constructed the first time it is needed and then shared by every handle
+    static const mersenne_twister_jump<engine_type>& run_jump(size_t i) {
+        static std::once_flag constructed[max_run_bits];
+        static std::unique_ptr<const mersenne_twister_jump<engine_type>> jumps[max_run_bits];
+        std::call_once(constructed[i], [i] {
+            jumps[i].reset(new mersenne_twister_jump<engine_type>(run_blocks * block_size, i));
+        });
+        return *jumps[i];
+    }
+
+    const engine_type start;
+    std::atomic<unsigned long long> next_run;
+};
+
+/*
+ * Generates values on a background thread into a single-producer/single-consumer ring buffer,
+ * so that the consuming thread usually only has to read the next value.
+ *
+ * The values are the same sequence as the engine would generate by itself. If the ring is empty,
+ * operator() generates the next value inline instead of waiting: the engine is owned by whichever
+ * side holds `engine_busy`, which the producer only holds while it fills part of the ring.
+ * When the ring is full, the producer sleeps until the consumer has freed up to half of it
+ * (with C++20 atomic waiting if available, otherwise a condition variable), and it sleeps the same way
+ * while operator() holds the engine.
+ *
+ * operator() must only be called from one thread at a time.
+ */
+template<class Engine>
+struct async_engine {
+    using engine_type = Engine;
+    using result_type = typename engine_type::result_type;
+    static constexpr size_t default_capacity = 16u * engine_type::state_size;
+
+    // `capacity` is rounded up to a power of two
+    explicit async_engine(const engine_type& e, size_t capacity = default_capacity) :
+        engine(e), capacity(round_up_to_power_of_two(capacity)), ring(new result_type[this->capacity]),
+        head(0u), tail(0u), cached_tail(0u), engine_busy(false), stopping(false),
+        producer([this] { produce(); }) {}
+    explicit async_engine(result_type value = engine_type::default_seed, size_t capacity = default_capacity) :
+        async_engine(engine_type(value), capacity) {}
+
+    async_engine(const async_engine&) = delete;
+    async_engine& operator=(const async_engine&) = delete;
+
+    ~async_engine() {
+        stopping.store(true, std::memory_order_relaxed);
+#if __cpp_lib_atomic_wait >= 201907L
+        // Drop the buffered values so a producer waiting for space wakes up
+        head.store(tail.load(std::memory_order_acquire), std::memory_order_release);
+        head.notify_one();
+#else
+        {
+            std::lock_guard<std::mutex> lock(wait_mutex);
+        }
+        wake.notify_one();
+#endif
+        producer.join();
+    }
+
+    static constexpr result_type min() noexcept { return engine_type::min(); }
+    static constexpr result_type max() noexcept { return engine_type::max(); }
+
+    result_type operator()() noexcept {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h == cached_tail) [[unlikely]] {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (h == cached_tail) return generate_inline(h);
+        }
+        return pop(h);
+    }
+
+private:
+    static size_t round_up_to_power_of_two(size_t x) noexcept {
+        size_t result = 1u;
+        while (result < x) result *= 2u;
+        return result;
+    }
+
+    // The producer is only woken when head reaches a multiple of this
+    size_t wake_interval() const noexcept {
+        return capacity == 1u ? 1u : capacity / 2u;
+    }
+
+    result_type pop(size_t h) noexcept {
+        const result_type x = ring[h & (capacity - 1u)];
+        head.store(h + 1u, std::memory_order_release);
+        if (((h + 1u) & (wake_interval() - 1u)) == 0u) [[unlikely]] {
+#if __cpp_lib_atomic_wait >= 201907L
+            head.notify_one();
+#else
+            wake_producer();
+#endif
+        }
+        return x;
+    }
+
+    void release_engine() noexcept {
+        engine_busy.store(false, std::memory_order_release);
+#if __cpp_lib_atomic_wait >= 201907L
+        engine_busy.notify_one();
+#else
+        wake_producer();
+#endif
+    }
+
+    result_type generate_inline(size_t h) noexcept {
+        bool expected = false;
+        while (!engine_busy.compare_exchange_weak(expected, true, std::memory_order_acquire, std::memory_order_relaxed)) {
+            expected = false;
+            // The producer is filling the ring, so wait for that instead
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (h != cached_tail) return pop(h);
+        }
+        // The producer might have published more values before giving up the engine
+        cached_tail = tail.load(std::memory_order_acquire);
+        if (h != cached_tail) {
+            release_engine();
+            return pop(h);
+        }
+        const result_type x = engine();
+        release_engine();
+        return x;
+    }
+
+#if __cpp_lib_atomic_wait >= 201907L
+    void wait_for_space(size_t full_head) noexcept {
+        const size_t needed = ((full_head | (wake_interval() - 1u)) + 1u) - full_head;
+        size_t h = full_head;
+        while (h - full_head < needed && !stopping.load(std::memory_order_relaxed)) {
+            head.wait(h, std::memory_order_acquire);
+            h = head.load(std::memory_order_acquire);
+        }
+    }
+
+    void wait_for_engine() noexcept {
+        engine_busy.wait(true, std::memory_order_relaxed);
+    }
+#else
+    // Blocks the producer until `ready()`, which must only become true after the consumer calls wake_producer()
+    template<class Ready>
+    void wait_until(Ready ready) noexcept {
+        std::unique_lock<std::mutex> lock(wait_mutex);
+        producer_waiting.store(true, std::memory_order_relaxed);
+        // Pairs with the fence in wake_producer(): either the consumer sees producer_waiting, or `ready()` sees its change
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wake.wait(lock, [&] { return stopping.load(std::memory_order_relaxed) || ready(); });
+        producer_waiting.store(false, std::memory_order_relaxed);
+    }
+
+    void wake_producer() noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (producer_waiting.load(std::memory_order_relaxed)) {
+            {
+                std::lock_guard<std::mutex> lock(wait_mutex);
+            }
+            wake.notify_one();
+        }
+    }
+
+    void wait_for_space(size_t full_head) noexcept {
+        const size_t needed = ((full_head | (wake_interval() - 1u)) + 1u) - full_head;
+        wait_until([&] { return head.load(std::memory_order_acquire) - full_head >= needed; });
+    }
+
+    void wait_for_engine() noexcept {
+        wait_until([&] { return !engine_busy.load(std::memory_order_relaxed); });
+    }
+#endif
+
+    void produce() noexcept {
+        // At most one block at a time, so the consumer is never kept waiting for the engine for long
+        constexpr size_t max_batch = engine_type::state_size;
+        while (!stopping.load(std::memory_order_relaxed)) {
+            const size_t t = tail.load(std::memory_order_relaxed);
+            const size_t h = head.load(std::memory_order_acquire);
+            const size_t free = capacity - (t - h);
+            if (free == 0u) {
+                wait_for_space(h);
+                continue;
+            }
+            const size_t start = t & (capacity - 1u);
+            size_t count = capacity - start;
+            if (count > free) count = free;
+            if (count > max_batch) count = max_batch;
+
+            bool expected = false;
+            if (!engine_busy.compare_exchange_strong(expected, true, std::memory_order_acquire, std::memory_order_relaxed)) {
+                wait_for_engine();
+                continue;
+            }
+            engine(ring.get() + start, ring.get() + start + count);
+            tail.store(t + count, std::memory_order_release);
+            engine_busy.store(false, std::memory_order_release);
+        }
+    }
+
+    engine_type engine;
+    const size_t capacity;
+    const std::unique_ptr<result_type[]> ring;
+    // Free running indices (the ring holds [head, tail)). Written by the consumer and producer respectively.
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+    // The consumer's last read of tail
+    alignas(64) size_t cached_tail;
+    std::atomic<bool> engine_busy;
+    std::atomic<bool> stopping;
+#if __cpp_lib_atomic_wait < 201907L
+    std::atomic<bool> producer_waiting{ false };
+    std::mutex wait_mutex;
+    std::condition_variable wake;
+#endif
+    std::thread producer;
+};
+
+#if __cpp_inline_variables < 201606L
+template<class Engine, size_t SubstreamExponent, class Tag>
+constexpr size_t thread_engine_registry<Engine, SubstreamExponent, Tag>::substream_exponent;
+template<class Engine, unsigned long long RunBlocks>
+constexpr size_t shared_block_engine<Engine, RunBlocks>::block_size;
+template<class Engine, unsigned long long RunBlocks>
+constexpr unsigned long long shared_block_engine<Engine, RunBlocks>::run_blocks;
+template<class Engine, unsigned long long RunBlocks>
+constexpr unsigned long long shared_block_engine<Engine, RunBlocks>::jump_threshold;
+template<class Engine, unsigned long long RunBlocks>
+constexpr size_t shared_block_engine<Engine, RunBlocks>::max_run_bits;
+template<class Engine>
+constexpr size_t async_engine<Engine>::default_capacity;
+#endif
+
+}
+
+#endif
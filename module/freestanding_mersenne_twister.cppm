@@ -0,0 +1,8 @@
+// C++20 module interface: `import freestanding_mersenne_twister;` instead of including
+// freestanding_mersenne_twister.h. The header has no includes of its own, so it is included
+// in the module purview with everything in the namespace exported.
+
+export module freestanding_mersenne_twister;
+
+#define FREESTANDING_MERSENNE_TWISTER_EXPORT export
+#include "freestanding_mersenne_twister.h"
@@ -0,0 +1,16 @@
+// Explicit instantiations of mt19937<> and mt19937_64<>, declared `extern template` by the header
+// when FREESTANDING_MERSENNE_TWISTER_EXTERN_TEMPLATES is defined.
+
+#include "freestanding_mersenne_twister.h"
+
+namespace freestanding_mersenne_twister {
+
+template struct mersenne_twister_state<detail::uint_least32_t, 624>;
+template struct mersenne_twister_engine<detail::uint_least32_t, 32, 624, 397, 31,
+        0x9908'b0dfu, 11, 0xffff'ffffu, 7, 0x9d2c'5680u, 15, 0xefc6'0000u, 18, 1'812'433'253u>;
+template struct mersenne_twister_state<detail::uint_least64_t, 312>;
+template struct mersenne_twister_engine<detail::uint_least64_t, 64, 312, 156, 31,
+        0xb502'6f5a'a966'19e9u, 29, 0x5555'5555'5555'5555u, 17,
+        0x71d6'7fff'eda6'0000u, 37, 0xfff7'eee0'0000'0000u, 43, 6'364'136'223'846'793'005u>;
+
+}
@@ -0,0 +1,152 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_ALGORITHMS
+
+#include <algorithm>
+#include <forward_list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+template<class Test>
+void check_shuffle(unsigned long long seed) {
+    using freestanding_mersenne_twister::shuffle;
+    for (size_t n : { 0u, 1u, 2u, 3u, 9u, 100u, 5000u }) {
+        std::vector<unsigned> v(n);
+        std::iota(v.begin(), v.end(), 0u);
+        std::vector<unsigned> w = v;
+        Test e1(seed);
+        Test e2(seed);
+        shuffle(v.begin(), v.end(), e1);
+        shuffle(w.data(), w.data() + n, e2);
+        REQUIRE(v == w);
+        REQUIRE(e1 == e2);
+        std::sort(w.begin(), w.end());
+        for (size_t j = 0; j < n; ++j) {
+            REQUIRE(w[j] == j);
+        }
+    }
+
+    // Every permutation of 4 elements is about equally likely
+    Test e(seed);
+    std::vector<int> counts(24);
+    for (int trial = 0; trial < 24'000; ++trial) {
+        int p[4] = { 0, 1, 2, 3 };
+        shuffle(p + 0, p + 4, e);
+        int index = 0;
+        for (int j = 0; j < 4; ++j) {
+            index = index * (4 - j) + static_cast<int>(std::count_if(p + j + 1, p + 4, [&](int x) { return x < p[j]; }));
+        }
+        ++counts[static_cast<size_t>(index)];
+    }
+    for (int count : counts) {
+        REQUIRE(count > 800);
+        REQUIRE(count < 1200);
+    }
+}
+
+template<class Test>
+void check_sample(unsigned long long seed) {
+    using freestanding_mersenne_twister::sample_selection;
+    using freestanding_mersenne_twister::sample_reservoir;
+    const std::forward_list<int> population = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    std::vector<int> selected(10);
+    std::vector<int> reservoir(10);
+    std::vector<int> selected_counts(10);
+    std::vector<int> reservoir_counts(10);
+    Test e(seed);
+    for (int trial = 0; trial < 10'000; ++trial) {
+        auto end = sample_selection(population.begin(), population.end(), selected.begin(), 3u, e);
+        REQUIRE(end - selected.begin() == 3);
+        REQUIRE(std::is_sorted(selected.begin(), end));
+        REQUIRE(std::adjacent_find(selected.begin(), end) == end);
+        for (auto it = selected.begin(); it != end; ++it) ++selected_counts[static_cast<size_t>(*it)];
+
+        end = sample_reservoir(population.begin(), population.end(), reservoir.begin(), 3u, e);
+        REQUIRE(end - reservoir.begin() == 3);
+        std::sort(reservoir.begin(), end);
+        REQUIRE(std::adjacent_find(reservoir.begin(), end) == end);
+        for (auto it = reservoir.begin(); it != end; ++it) ++reservoir_counts[static_cast<size_t>(*it)];
+    }
+    for (size_t j = 0; j < 10; ++j) {
+        REQUIRE(selected_counts[j] > 2'700);
+        REQUIRE(selected_counts[j] < 3'300);
+        REQUIRE(reservoir_counts[j] > 2'700);
+        REQUIRE(reservoir_counts[j] < 3'300);
+    }
+
+    // Asking for more than there are takes everything
+    REQUIRE(sample_selection(population.begin(), population.end(), selected.begin(), 20u, e) == selected.end());
+    REQUIRE(std::equal(selected.begin(), selected.end(), population.begin()));
+    REQUIRE(sample_reservoir(population.begin(), population.end(), reservoir.begin(), 20u, e) == reservoir.end());
+    REQUIRE(std::equal(reservoir.begin(), reservoir.end(), population.begin()));
+
+    // Deterministic
+    Test e1(seed);
+    Test e2(seed);
+    std::vector<int> large(100'000);
+    std::iota(large.begin(), large.end(), 0);
+    std::vector<int> s1(1'000);
+    std::vector<int> s2(1'000);
+    sample_reservoir(large.begin(), large.end(), s1.begin(), s1.size(), e1);
+    sample_reservoir(large.begin(), large.end(), s2.begin(), s2.size(), e2);
+    REQUIRE(s1 == s2);
+    REQUIRE(e1 == e2);
+}
+
+template<class Test>
+void check_choose_k(unsigned long long seed) {
+    using freestanding_mersenne_twister::choose_k;
+    Test e(seed);
+    // (Floyd's algorithm for the first two, selection sampling for the rest)
+    for (auto nk : { std::make_pair(1'000'000ull, 100ull), std::make_pair(10ull, 3ull), std::make_pair(20ull, 15ull), std::make_pair(5ull, 5ull), std::make_pair(5ull, 9ull) }) {
+        std::vector<unsigned long long> out(nk.second);
+        const auto end = choose_k(nk.first, nk.second, out.begin(), e);
+        REQUIRE(static_cast<unsigned long long>(end - out.begin()) == std::min(nk.first, nk.second));
+        REQUIRE(std::adjacent_find(out.begin(), end, [](unsigned long long x, unsigned long long y) { return x >= y; }) == end);
+        REQUIRE((end == out.begin() || *(end - 1) < nk.first));
+    }
+
+    for (unsigned long long k : { 3ull, 8ull }) {
+        std::vector<int> counts(10);
+        for (int trial = 0; trial < 10'000; ++trial) {
+            unsigned long long out[8];
+            const auto end = choose_k(10u, k, out + 0, e);
+            for (auto it = out + 0; it != end; ++it) ++counts[*it];
+        }
+        for (int count : counts) {
+            REQUIRE(count > static_cast<int>(k) * 900);
+            REQUIRE(count < static_cast<int>(k) * 1'100);
+        }
+    }
+}
+}
+
+TEST_CASE( "Shuffling and sampling" ) {
+#if MT_TEST_SUPPORTS_WIDTH(32)
+    SECTION( "mt19937" ) {
+        check_shuffle<test32>(5489u);
+        check_sample<test32>(5489u);
+        check_choose_k<test32>(5489u);
+    }
+#endif
+#if MT_TEST_SUPPORTS_WIDTH(64)
+    SECTION( "mt19937_64" ) {
+        check_shuffle<test64>(1u);
+        check_sample<test64>(1u);
+        check_choose_k<test64>(1u);
+    }
+#endif
+#if MT_TEST_SUPPORTS_WIDTH(32)
+    SECTION( "Elements with their own swap" ) {
+        std::vector<std::string> v = { "a", "b", "c", "d", "e" };
+        test32 e;
+        freestanding_mersenne_twister::shuffle(v.begin(), v.end(), e);
+        std::sort(v.begin(), v.end());
+        REQUIRE(v == std::vector<std::string>{ "a", "b", "c", "d", "e" });
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,100 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_ALIAS_TABLE
+
+#include <cmath>
+#include <vector>
+
+namespace {
+// The probability of each index, from the thresholds and aliases of the table
+template<size_t N>
+std::vector<long double> probabilities(const freestanding_mersenne_twister::alias_table<N>& table) {
+    std::vector<long double> p(N);
+    for (size_t j = 0; j < N; ++j) {
+        REQUIRE(table[j].alias < N);
+        const long double keep = table[j].alias == j ? 1.0L : std::ldexp(static_cast<long double>(table[j].threshold), -64);
+        p[j] += keep / N;
+        p[table[j].alias] += (1.0L - keep) / N;
+    }
+    return p;
+}
+
+template<size_t N>
+void check_table(const unsigned long long (&weights)[N]) {
+    const freestanding_mersenne_twister::alias_table<N> table(weights);
+    const auto p = probabilities(table);
+    long double total = 0;
+    for (auto weight : weights) total += static_cast<long double>(weight);
+    for (size_t j = 0; j < N; ++j) {
+        REQUIRE(std::fabs(p[j] - static_cast<long double>(weights[j]) / total) < 1e-15L);
+        if (weights[j] == 0u) {
+            REQUIRE(table[j].alias != j);
+            REQUIRE(table[j].threshold == 0u);
+        }
+    }
+}
+
+template<class Test, size_t N>
+void check_sampling(const freestanding_mersenne_twister::alias_table<N>& table, unsigned long long seed) {
+    Test e(seed);
+    Test f(seed);
+    std::vector<size_t> samples(10000);
+    table.sample(e, samples.begin(), samples.end());
+    for (auto x : samples) {
+        REQUIRE(x == table(f));
+    }
+    REQUIRE(e == f);
+}
+
+#if __cpp_constexpr >= 201304L && MT_TEST_SUPPORTS_WIDTH(64)
+constexpr unsigned long long die_weights[6] = { 1, 1, 1, 1, 1, 5 };
+constexpr freestanding_mersenne_twister::alias_table<6> loaded_die(die_weights);
+static_assert(loaded_die[5].alias == 5 && loaded_die[0].alias == 5, "alias_table in a constant expression");
+constexpr size_t roll() {
+    test64 e;
+    return loaded_die(e);
+}
+static_assert(roll() == 5u, "sampling in a constant expression");
+#endif
+}
+
+TEST_CASE( "Alias tables" ) {
+    SECTION( "Probabilities" ) {
+        check_table({ 1 });
+        check_table({ 1, 1, 1, 1 });
+        check_table({ 0, 3, 0, 1 });
+        check_table({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 });
+        check_table({ 1'000'000'000'000u, 1, 1, 1, 1, 1, 1 });
+        check_table({ 0x0fff'ffff'ffff'ffffu, 0x1000'0000'0000'0000u, 1, 0 });
+
+        std::mt19937_64 g(1);
+        static unsigned long long weights[5000];
+        for (auto& weight : weights) weight = g() >> 30u;
+        check_table(weights);
+    }
+    SECTION( "Sampling" ) {
+        constexpr unsigned long long weights[5] = { 1, 2, 0, 3, 4 };
+        const freestanding_mersenne_twister::alias_table<5> table(weights);
+#if MT_TEST_SUPPORTS_WIDTH(64)
+        check_sampling<test64>(table, 5489u);
+#endif
+#if MT_TEST_SUPPORTS_WIDTH(32)
+        check_sampling<test32>(table, 1u);
+#endif
+        using both = mt_both<unsigned long long, 24, 17, 13, 5, 0xaee3fau, 3, 0x583863u, 2, 0xd0fef6u, 7, 0xc3a13bu, 11, 0x93caf6u>;
+        check_sampling<typename both::test>(table, 12u);
+
+        typename both::test e(1u);
+        std::vector<unsigned long long> counts(5);
+        for (int i = 0; i < 100000; ++i) {
+            ++counts[table(e)];
+        }
+        REQUIRE(counts[2] == 0u);
+        for (size_t j = 0; j < 5; ++j) {
+            const double expected = 10000.0 * static_cast<double>(weights[j]);
+            REQUIRE(std::fabs(static_cast<double>(counts[j]) - expected) <= 5.0 * std::sqrt(expected + 1.0));
+        }
+    }
+}
+
+#endif
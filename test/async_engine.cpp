@@ -0,0 +1,49 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_THREADS
+
+#include <chrono>
+#include <thread>
+
+#include "freestanding_mersenne_twister_threads.h"
+
+namespace {
+template<class Test, class Base>
+void check_async(unsigned long long seed, size_t capacity) {
+    freestanding_mersenne_twister::async_engine<Test> e(Test(seed), capacity);
+    Base b(seed);
+    for (int i = 0; i < 100'000; ++i) {
+        REQUIRE(e() == b());
+        if (i % 10'000 == 0) {
+            // Give the producer time to fill the ring
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+}
+
+TEST_CASE( "Asynchronous engine" ) {
+#if MT_SUPPORTS_WIDTH(32)
+    SECTION( "mt19937" ) {
+        check_async<test32, base32>(5489u, 1);
+        check_async<test32, base32>(1u, 100);
+        check_async<test32, base32>(1u, freestanding_mersenne_twister::async_engine<test32>::default_capacity);
+    }
+    SECTION( "Destroyed while the producer waits for space" ) {
+        for (size_t capacity : { 1u, 2u, 624u }) {
+            freestanding_mersenne_twister::async_engine<test32> e(test32(5489u), capacity);
+            base32 b(5489u);
+            REQUIRE(e() == b());
+            // The ring fills up, and the destructor has to wake the producer
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+#endif
+#if MT_SUPPORTS_WIDTH(64)
+    SECTION( "mt19937_64" ) {
+        check_async<test64, base64>(5489u, 4096);
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,115 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_BIT_POOL
+
+#include <limits>
+#include <vector>
+
+namespace {
+template<class Base, class Test, size_t BufferSize>
+void check_bit_pool(unsigned long long seed) {
+    using pool_type = freestanding_mersenne_twister::bit_pool<Test, BufferSize>;
+    constexpr size_t w = Test::word_size;
+    Base b(seed);
+    std::vector<bool> expected;
+    for (int i = 0; i < 2000; ++i) {
+        auto x = b();
+        for (size_t j = 0; j < w; ++j) {
+            expected.push_back(((x >> j) & 1u) != 0u);
+        }
+    }
+
+    {
+        pool_type pool{Test(seed)};
+        for (size_t j = 0; j < expected.size(); ++j) {
+            REQUIRE(pool.next_bool() == expected[j]);
+        }
+    }
+    {
+        // Pieces of every size, some crossing from one value to the next
+        pool_type pool{Test(seed)};
+        size_t position = 0;
+        for (size_t k = 1; position + w <= expected.size(); k = k % w + 1u) {
+            const auto x = pool.next_bits(k);
+            REQUIRE(x <= (Test::max() >> (w - k)));
+            for (size_t j = 0; j < k; ++j) {
+                REQUIRE((((x >> j) & 1u) != 0u) == expected[position + j]);
+            }
+            position += k;
+            REQUIRE(pool.bits_available() % w == (w - position % w) % w);
+        }
+    }
+    {
+        pool_type pool{Test(seed)};
+        std::vector<unsigned long long> counts(7);
+        for (int i = 0; i < 70000; ++i) {
+            const auto x = pool.next_below(7u);
+            REQUIRE(x < 7u);
+            ++counts[x];
+        }
+        for (auto count : counts) {
+            REQUIRE(count > 9000u);
+            REQUIRE(count < 11000u);
+        }
+        for (int i = 0; i < 1000; ++i) {
+            REQUIRE(pool.next_below(1u) == 0u);
+            REQUIRE(pool.next_below(Test::max()) < Test::max());
+        }
+    }
+    using result_type = typename pool_type::result_type;
+    if (std::numeric_limits<result_type>::digits >= static_cast<int>(w + 2u)) {
+        // Bounds wider than a word take their bits from more than one value
+        const auto bound = static_cast<result_type>(static_cast<result_type>(Test::max()) * 3u);
+        const size_t k = w + 2u;
+        pool_type pool{Test(seed)};
+        size_t position = 0;
+        for (int i = 0; i < 200; ++i) {
+            const auto x = pool.next_below(bound);
+            result_type y;
+            do {
+                REQUIRE(position + k <= expected.size());
+                y = 0;
+                for (size_t j = 0; j < k; ++j) {
+                    y = static_cast<result_type>(y | static_cast<result_type>(static_cast<result_type>(expected[position + j]) << j));
+                }
+                position += k;
+            } while (y >= bound);
+            REQUIRE(x == y);
+        }
+    }
+}
+
+#if __cpp_constexpr >= 201304L && MT_TEST_SUPPORTS_WIDTH(32)
+constexpr unsigned count_heads(unsigned flips) {
+    freestanding_mersenne_twister::bit_pool<test32, 4> pool;
+    unsigned heads = 0;
+    for (unsigned i = 0; i < flips; ++i) {
+        heads += pool.next_bool() ? 1u : 0u;
+    }
+    return heads;
+}
+// The number of set bits in the first 10 values of mt19937
+static_assert(count_heads(320) == 165u, "bit_pool<mt19937<>> in a constant expression");
+#endif
+}
+
+TEST_CASE( "Bit pools" ) {
+#if MT_SUPPORTS_WIDTH(32)
+    SECTION( "mt19937" ) {
+        check_bit_pool<base32, test32, 32>(5489u);
+        check_bit_pool<base32, test32, 1>(1u);
+    }
+#endif
+#if MT_SUPPORTS_WIDTH(64)
+    SECTION( "mt19937_64" ) {
+        check_bit_pool<base64, test64, 32>(1u);
+        check_bit_pool<base64, test64, 624>(5489u);
+    }
+#endif
+    SECTION( "Other parameters" ) {
+        using both = mt_both<unsigned long long, 24, 17, 13, 5, 0xaee3fau, 3, 0x583863u, 2, 0xd0fef6u, 7, 0xc3a13bu, 11, 0x93caf6u>;
+        check_bit_pool<typename both::base, typename both::test, 5>(12u);
+    }
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_GENERATE_BYTES
+
+#include <vector>
+
+namespace {
+template<class Base, class Test>
+void check_bytes(unsigned long long seed) {
+    constexpr size_t bytes_per_word = Test::word_size / 8u;
+    Base b(seed);
+    std::vector<unsigned char> expected;
+    for (int i = 0; i < 1000; ++i) {
+        auto x = b();
+        for (size_t j = 0; j < bytes_per_word; ++j) {
+            expected.push_back(static_cast<unsigned char>(x >> (8u * j)));
+        }
+    }
+
+    {
+        freestanding_mersenne_twister::byte_generator<Test> g{Test(seed)};
+        std::vector<unsigned char> actual(expected.size());
+        g.generate_bytes(actual.data(), actual.size());
+        REQUIRE(actual == expected);
+    }
+    {
+        // Unaligned pieces of every size, some smaller than a word
+        freestanding_mersenne_twister::byte_generator<Test> g{Test(seed)};
+        std::vector<unsigned char> actual(expected.size() + 1u);
+        size_t offset = 1;
+        for (size_t len = 0; offset + len <= actual.size(); ++len) {
+            g.generate_bytes(actual.data() + offset, len);
+            offset += len;
+        }
+        g.generate_bytes(actual.data() + offset, actual.size() - offset);
+        REQUIRE(std::vector<unsigned char>(actual.begin() + 1, actual.end()) == expected);
+    }
+    {
+        freestanding_mersenne_twister::byte_generator<Test> g{Test(seed)};
+        freestanding_mersenne_twister::byte_generator<Test> h{Test(seed)};
+        for (size_t i = 0; i < expected.size(); ++i) {
+            REQUIRE(g == h);
+            REQUIRE(g() == expected[i]);
+            h.discard(1);
+        }
+        REQUIRE(g == h);
+    }
+}
+}
+
+TEST_CASE( "Generating bytes" ) {
+#if MT_SUPPORTS_WIDTH(32)
+    SECTION( "mt19937" ) {
+        check_bytes<base32, test32>(5489u);
+    }
+#endif
+#if MT_SUPPORTS_WIDTH(64)
+    SECTION( "mt19937_64" ) {
+        check_bytes<base64, test64>(1u);
+    }
+#endif
+    SECTION( "Other parameters" ) {
+        using both = mt_both<unsigned long long, 24, 17, 13, 5, 0xaee3fau, 3, 0x583863u, 2, 0xd0fef6u, 7, 0xc3a13bu, 11, 0x93caf6u>;
+        check_bytes<typename both::base, typename both::test>(12u);
+    }
+}
+
+#endif
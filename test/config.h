@@ -69,6 +69,21 @@ using mt_test = freestanding_mersenne_twister::mersenne_twister_engine<UIntType,
 #define MT_TEST_HAS_PEEK
 #define MT_TEST_HAS_PEEK_ITERATOR
 #define MT_TEST_HAS_STREAM_INSERTION
+#define MT_TEST_HAS_FROM_OUTPUTS
+#define MT_TEST_HAS_GENERATE_BYTES
+#define MT_TEST_HAS_VIEWS
+#define MT_TEST_HAS_JUMP
+#define MT_TEST_HAS_THREADS
+#define MT_TEST_HAS_ALGORITHMS
+#define MT_TEST_HAS_RANDOM_ARRAY
+#define MT_TEST_HAS_STREAM_DESCRIPTOR
+#define MT_TEST_HAS_DYNAMIC_CREATOR
+#define MT_TEST_HAS_ENGINE_ARRAY
+#define MT_TEST_HAS_BIT_POOL
+#define MT_TEST_HAS_ALIAS_TABLE
+#define MT_TEST_HAS_LAZY_SEED
+#define MT_TEST_HAS_DYNAMIC_ENGINE
+#define MT_TEST_HAS_PACKED_ENGINE
 
 
 // Config end
@@ -0,0 +1,117 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_DYNAMIC_CREATOR
+
+#include <cstdint>
+#include <vector>
+
+#include "freestanding_mersenne_twister_dynamic_creator.h"
+
+namespace {
+// Whether the recurrence has period 2**exponent - 1, by stepping through the whole period
+template<class Creator>
+bool brute_force_has_maximal_period(unsigned xor_mask) {
+    constexpr size_t n = Creator::state_size;
+    constexpr size_t m = Creator::shift_size;
+    constexpr unsigned word_mask = (1u << Creator::word_size) - 1u;
+    constexpr unsigned lower_mask = (1u << Creator::mask_bits) - 1u;
+    constexpr unsigned upper_mask = word_mask & ~lower_mask;
+    constexpr unsigned long long period = (1ull << Creator::exponent) - 1u;
+
+    std::vector<unsigned> initial(n);
+    for (size_t j = 0; j < n; ++j) initial[j] = static_cast<unsigned>(37u * j + 1u) & word_mask;
+    std::vector<unsigned> X = initial;
+    for (unsigned long long step = 1; step <= period; ++step) {
+        const size_t k = static_cast<size_t>((step - 1u) % n);
+        const unsigned y = (X[k] & upper_mask) | (X[(k + 1u) % n] & lower_mask);
+        X[k] = X[(k + m) % n] ^ (y >> 1u) ^ ((y & 1u) ? xor_mask : 0u);
+        // The state is the upper bits of the oldest word and the other n - 1 words
+        const size_t start = static_cast<size_t>(step % n);
+        bool same = (X[start] & upper_mask) == (initial[0] & upper_mask);
+        for (size_t j = 1; same && j < n; ++j) {
+            same = X[(start + j) % n] == initial[j];
+        }
+        if (same) return step == period;
+    }
+    return false;
+}
+
+// Found by `mtdc 0 -p 521` (tools/mtdc.cpp)
+using mt32_521_0 = freestanding_mersenne_twister::mersenne_twister_engine<std::uint_least32_t, 32, 17, 8, 23,
+        0xdafe0000u, 11, 0xffffffffu, 7, 0x692af000u, 15, 0xbaec0000u, 18, 1812433253u>;
+}
+
+TEST_CASE( "Dynamic creator" ) {
+    using freestanding_mersenne_twister::dynamic_creator;
+    using freestanding_mersenne_twister::mersenne_twister_parameters;
+
+    SECTION( "Maximal period test agrees with stepping through the period" ) {
+        using creator = dynamic_creator<std::uint_least8_t, 8, 17>;
+        REQUIRE(creator::state_size == 3);
+        REQUIRE(creator::mask_bits == 7);
+        int maximal = 0;
+        for (unsigned a = 0x80u; a <= 0xffu; ++a) {
+            const bool expected = brute_force_has_maximal_period<creator>(a);
+            REQUIRE(creator::has_maximal_period(static_cast<std::uint_least8_t>(a)) == expected);
+            maximal += expected;
+        }
+        REQUIRE(maximal > 0);
+        REQUIRE(maximal < 128);
+    }
+
+    SECTION( "Parameter sets for different ids" ) {
+        using creator = dynamic_creator<std::uint_least32_t, 32, 127>;
+        std::vector<mersenne_twister_parameters<std::uint_least32_t>> found;
+        for (unsigned long long id = 0; id < 4; ++id) {
+            mersenne_twister_parameters<std::uint_least32_t> p{};
+            REQUIRE(creator::create(id, 1234u, p));
+            REQUIRE(p.word_size == 32);
+            REQUIRE(p.state_size == 4);
+            REQUIRE(p.shift_size == 2);
+            REQUIRE(p.mask_bits == 1);
+            REQUIRE((p.xor_mask & 0xffffu) == id);
+            REQUIRE((p.xor_mask >> 31u) == 1u);
+            REQUIRE((p.tempering_b & 0x7fu) == 0u);
+            REQUIRE((p.tempering_c & 0x7fffu) == 0u);
+            REQUIRE(creator::has_maximal_period(p.xor_mask));
+            for (const auto& q : found) REQUIRE(q != p);
+            found.push_back(p);
+
+            mersenne_twister_parameters<std::uint_least32_t> again{};
+            REQUIRE(creator::create(id, 1234u, again));
+            REQUIRE(again == p);
+        }
+        mersenne_twister_parameters<std::uint_least32_t> p{};
+        REQUIRE(!creator::create(1u << 16u, 1234u, p));
+    }
+
+    SECTION( "Found parameters make a working engine" ) {
+        using creator = dynamic_creator<std::uint_least32_t, 32, 521>;
+        mersenne_twister_parameters<std::uint_least32_t> p{};
+        REQUIRE(creator::create(0u, 4172u, p));
+        REQUIRE(p == mersenne_twister_parameters<std::uint_least32_t>::of<mt32_521_0>());
+
+        // Jumping relies on the maximal period
+        mt32_521_0 jumped(5489u);
+        mt32_521_0 discarded(5489u);
+        freestanding_mersenne_twister::mersenne_twister_jump<mt32_521_0>(100'003u).apply(jumped);
+        discarded.discard(100'003u);
+        REQUIRE(jumped == discarded);
+        REQUIRE(jumped() == discarded());
+    }
+
+#if MT_TEST_SUPPORTS_WIDTH(32)
+    SECTION( "Parameters of an engine" ) {
+        const auto p = mersenne_twister_parameters<test32::result_type>::of<test32>();
+        REQUIRE(p.word_size == 32);
+        REQUIRE(p.state_size == 624);
+        REQUIRE(p.shift_size == 397);
+        REQUIRE(p.mask_bits == 31);
+        REQUIRE(p.xor_mask == 0x9908'b0dfu);
+        REQUIRE(p.tempering_b == 0x9d2c'5680u);
+        REQUIRE(p.initialization_multiplier == 1'812'433'253u);
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,92 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_DYNAMIC_ENGINE
+
+#include <vector>
+
+namespace {
+template<class Base, class Test, class UIntType = unsigned long long>
+void check_dynamic(typename Test::result_type seed, bool specialized) {
+    using dynamic_type = freestanding_mersenne_twister::dynamic_mersenne_twister_engine<UIntType>;
+    using parameters_type = typename dynamic_type::parameters_type;
+    constexpr size_t n = Test::state_size;
+    const parameters_type parameters = parameters_type::template of<Test>();
+    REQUIRE(dynamic_type::valid(parameters));
+
+    std::vector<UIntType> buffer(n);
+    dynamic_type d(parameters, buffer.data(), seed);
+    REQUIRE(d.specialized() == specialized);
+    REQUIRE(d.max() == Test::max());
+    {
+        Test e(seed);
+        for (size_t j = 0; j < n; ++j) {
+            REQUIRE(d.data()[j] == e.X[j]);
+        }
+        REQUIRE(d.index() == e.i);
+    }
+
+    Base b(seed);
+    for (size_t j = 0; j < 3u * n + 5u; ++j) {
+        REQUIRE(d() == b());
+    }
+
+    // Block path, with every alignment relative to the state
+    std::vector<UIntType> values;
+    for (size_t count : { size_t{0}, size_t{1}, n - 1u, n, n + 1u, 3u * n + 2u }) {
+        values.assign(count, 0u);
+        REQUIRE(d(values.data(), values.data() + count) == values.data() + count);
+        for (auto x : values) {
+            REQUIRE(x == b());
+        }
+    }
+
+    std::vector<UIntType> other_buffer(n);
+    dynamic_type copy(d, other_buffer.data());
+    REQUIRE(copy == d);
+    d.discard(2u * n + 3u);
+    b.discard(2u * n + 3u);
+    REQUIRE(copy != d);
+    REQUIRE(d() == b());
+    copy.seed(seed);
+    REQUIRE(copy() == Base(seed)());
+    REQUIRE(dynamic_type(parameters, other_buffer.data()) == dynamic_type(parameters, buffer.data(), static_cast<UIntType>(Test::default_seed)));
+}
+}
+
+TEST_CASE( "Dynamic engine" ) {
+#if MT_SUPPORTS_WIDTH(32)
+    SECTION( "mt19937" ) {
+        check_dynamic<base32, test32>(5489u, true);
+        check_dynamic<base32, test32, std::uint32_t>(1u, true);
+    }
+#endif
+#if MT_SUPPORTS_WIDTH(64)
+    SECTION( "mt19937_64" ) {
+        check_dynamic<base64, test64>(5489u, true);
+        check_dynamic<base64, test64>(1u, true);
+    }
+#endif
+    SECTION( "Other parameters" ) {
+        using both = mt_both<unsigned long long, 24, 17, 13, 5, 0xaee3fau, 3, 0x583863u, 2, 0xd0fef6u, 7, 0xc3a13bu, 11, 0x93caf6u>;
+        check_dynamic<typename both::base, typename both::test>(12u, false);
+        using same = mt_both<unsigned long long, 24, 17, 17, 5, 0xaee3fau, 3, 0x583863u, 2, 0xd0fef6u, 7, 0xc3a13bu, 11, 0x93caf6u>;
+        check_dynamic<typename same::base, typename same::test>(12u, false);
+        // Only one parameter different from mt19937
+        using almost = mt_both<std::uint32_t, 32, 624, 397, 31, 0x9908'b0dfu, 11, 0xffff'ffffu, 7, 0x9d2c'5680u, 15, 0xefc6'0000u, 18, 1'812'433'255u>;
+        check_dynamic<typename almost::base, typename almost::test>(5489u, false);
+    }
+    SECTION( "Validation" ) {
+        using parameters_type = freestanding_mersenne_twister::mersenne_twister_parameters<std::uint32_t>;
+        auto parameters = parameters_type::of<freestanding_mersenne_twister::mt19937<std::uint32_t>>();
+        REQUIRE(freestanding_mersenne_twister::dynamic_mersenne_twister_engine<std::uint32_t>::valid(parameters));
+        parameters.shift_size = 625;
+        REQUIRE(!freestanding_mersenne_twister::dynamic_mersenne_twister_engine<std::uint32_t>::valid(parameters));
+        parameters.shift_size = 397;
+        parameters.word_size = 33;
+        REQUIRE(!freestanding_mersenne_twister::dynamic_mersenne_twister_engine<std::uint32_t>::valid(parameters));
+        parameters.word_size = 31;
+        REQUIRE(!freestanding_mersenne_twister::dynamic_mersenne_twister_engine<std::uint32_t>::valid(parameters));
+    }
+}
+
+#endif
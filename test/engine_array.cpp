@@ -0,0 +1,61 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_ENGINE_ARRAY
+
+#include <cstdint>
+
+namespace {
+template<class Test, size_t N, size_t Alignment>
+void check_engine_array() {
+    using array = freestanding_mersenne_twister::engine_array<Test, N, Alignment>;
+    static_assert(alignof(array) == Alignment, "engine_array alignment");
+    static_assert(sizeof(typename array::slot) % Alignment == 0u, "slots are padded to the alignment");
+    static_assert(sizeof(typename array::slot) < sizeof(Test) + Alignment, "slots are not padded more than needed");
+    // The layout of each engine is unchanged
+    static_assert(sizeof(Test) == sizeof(typename Test::result_type) * Test::state_size + sizeof(size_t) ||
+                  alignof(Test) > alignof(size_t), "mersenne_twister_state has no padding");
+
+    array engines;
+    REQUIRE(engines.size() == N);
+    size_t count = 0;
+    for (Test& e : engines) {
+        REQUIRE(reinterpret_cast<std::uintptr_t>(&e) % Alignment == 0u);
+        REQUIRE(&e == &engines[count]);
+        ++count;
+    }
+    REQUIRE(count == N);
+    for (size_t j = 0; j + 1u < N; ++j) {
+        // The last byte of an engine and the first byte of the next are in different blocks of `Alignment` bytes
+        const std::uintptr_t last = reinterpret_cast<std::uintptr_t>(&engines[j]) + sizeof(Test) - 1u;
+        const std::uintptr_t next = reinterpret_cast<std::uintptr_t>(&engines[j + 1u]);
+        REQUIRE(last / Alignment != next / Alignment);
+    }
+
+    engines.assign_substreams(Test(1234u), freestanding_mersenne_twister::mersenne_twister_jump<Test>(1000u));
+    Test expected(1234u);
+    for (size_t j = 0; j < N; ++j) {
+        REQUIRE(engines[j] == expected);
+        expected.discard(1000u);
+    }
+    const Test first = engines[0];
+    Test copy = first;
+    REQUIRE(engines[0]() == copy());
+    REQUIRE(engines[1] != engines[0]);
+}
+}
+
+TEST_CASE( "Engine arrays" ) {
+#if MT_TEST_SUPPORTS_WIDTH(32)
+    SECTION( "mt19937" ) {
+        check_engine_array<test32, 3, 64>();
+        check_engine_array<test32, 2, 128>();
+    }
+#endif
+#if MT_TEST_SUPPORTS_WIDTH(64)
+    SECTION( "mt19937_64" ) {
+        check_engine_array<test64, 4, 64>();
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_CALL_ITERATOR
+
+#include <vector>
+#include <list>
+
+namespace {
+template<class Test, class Base>
+void check_generate_range(unsigned long long seed) {
+    constexpr size_t n = Test::state_size;
+    const size_t lengths[] = { 0, 1, 2, n - 1, n, n + 1, 2 * n - 1, 2 * n, 3 * n + 5, 7 * n };
+    for (size_t skip : { size_t{0}, size_t{1}, n / 2u, n - 1u, n }) {
+        for (size_t length : lengths) {
+            Test pointer(seed);
+            Test iterator(seed);
+            Base b(seed);
+            pointer.discard(skip);
+            iterator.discard(skip);
+            mt_base_discard(b, skip);
+
+            std::vector<typename Test::result_type> contiguous(length);
+            std::list<typename Test::result_type> linked(length);
+            REQUIRE(pointer(contiguous.data(), contiguous.data() + length) == contiguous.data() + length);
+            REQUIRE(iterator(linked.begin(), linked.end()) == linked.end());
+            REQUIRE(pointer == iterator);
+
+            auto it = linked.begin();
+            for (size_t i = 0; i < length; ++i, ++it) {
+                auto expected = b();
+                REQUIRE(contiguous[i] == expected);
+                REQUIRE(*it == expected);
+            }
+            for (int i = 0; i < 65; ++i) {
+                REQUIRE(pointer() == b());
+            }
+        }
+    }
+}
+}
+
+TEST_CASE( "Generating ranges" ) {
+#if MT_SUPPORTS_WIDTH(32)
+    SECTION( "mt19937" ) {
+        check_generate_range<test32, base32>(5489u);
+    }
+#endif
+#if MT_SUPPORTS_WIDTH(64)
+    SECTION( "mt19937_64" ) {
+        check_generate_range<test64, base64>(5489u);
+    }
+#endif
+    SECTION( "shift_size == state_size" ) {
+        using both = mt_both<unsigned long long, 13, 5, 5, 3, 0x1affu, 3, 0x1583u, 2, 0x0ef6u, 7, 0x013bu, 11, 0x0af6u>;
+        check_generate_range<typename both::test, typename both::base>(12u);
+    }
+    SECTION( "state_size == 1" ) {
+        using both = mt_both<unsigned long long, 13, 1, 1, 3, 0x1affu, 3, 0x1583u, 2, 0x0ef6u, 7, 0x013bu, 11, 0x0af6u>;
+        check_generate_range<typename both::test, typename both::base>(12u);
+    }
+}
+
+#endif
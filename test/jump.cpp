@@ -0,0 +1,54 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_JUMP
+
+namespace {
+template<class Test>
+void check_jump(unsigned long long seed, size_t skip, unsigned long long distance, size_t exponent) {
+    Test jumped(seed);
+    Test discarded(seed);
+    jumped.discard(skip);
+    discarded.discard(skip);
+
+    freestanding_mersenne_twister::mersenne_twister_jump<Test>(distance, exponent).apply(jumped);
+    discarded.discard(distance << exponent);
+    REQUIRE(jumped == discarded);
+    for (int i = 0; i < 65; ++i) {
+        REQUIRE(jumped() == discarded());
+    }
+}
+}
+
+TEST_CASE( "Jumping ahead" ) {
+#if MT_TEST_SUPPORTS_WIDTH(32)
+    SECTION( "mt19937" ) {
+        check_jump<test32>(5489u, 0, 0, 0);
+        check_jump<test32>(5489u, 0, 1, 0);
+        check_jump<test32>(5489u, 623, 1, 0);
+        check_jump<test32>(1u, 5, 624, 0);
+        check_jump<test32>(1u, 600, 123'457, 0);
+        check_jump<test32>(1u, 3, 3, 10);
+    }
+#endif
+#if MT_TEST_SUPPORTS_WIDTH(64)
+    SECTION( "mt19937_64" ) {
+        check_jump<test64>(5489u, 0, 312, 0);
+        check_jump<test64>(1u, 311, 10'000, 0);
+        check_jump<test64>(1u, 7, 1, 17);
+    }
+#endif
+#if MT_TEST_SUPPORTS_WIDTH(32)
+    SECTION( "Composing jumps" ) {
+        // 2**40 in two different ways
+        test32 a(1u);
+        test32 b(1u);
+        freestanding_mersenne_twister::mersenne_twister_jump<test32>(1u, 40).apply(a);
+        const freestanding_mersenne_twister::mersenne_twister_jump<test32> half(1u << 20, 19);
+        half.apply(b);
+        half.apply(b);
+        REQUIRE(a == b);
+    }
+#endif
+}
+
+#endif
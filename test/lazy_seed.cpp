@@ -0,0 +1,85 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_LAZY_SEED
+
+namespace {
+template<class Base, class Test>
+void check_lazy_seed(typename Test::result_type seed) {
+    using lazy_type = freestanding_mersenne_twister::lazy_seed_engine<Test>;
+    constexpr size_t n = Test::state_size;
+
+    {
+        lazy_type lazy(seed);
+        Base b(seed);
+        for (size_t j = 0; j < 3u * n; ++j) {
+            REQUIRE(lazy() == b());
+        }
+        Test e(seed);
+        e.discard(3u * n);
+        REQUIRE(lazy.complete() == e);
+    }
+    for (size_t drawn : { size_t{0}, size_t{1}, n / 2u, n - 1u, n, n + 1u }) {
+        lazy_type lazy(seed);
+        Test e(seed);
+        for (size_t j = 0; j < drawn; ++j) {
+            REQUIRE(lazy() == e());
+        }
+        REQUIRE(lazy == lazy_type(lazy));
+        REQUIRE(lazy.complete() == e);
+    }
+    for (unsigned long long z : { 0ull, 1ull, 5ull, n - 2ull, n - 1ull, n + 0ull, 3ull * n + 7u }) {
+        lazy_type lazy(seed);
+        Test e(seed);
+        REQUIRE(lazy() == e());
+        REQUIRE(lazy() == e());
+        lazy.discard(z);
+        e.discard(z);
+        REQUIRE(lazy() == e());
+        REQUIRE(lazy == lazy_type(lazy));
+        REQUIRE(lazy.complete() == e);
+    }
+    {
+        lazy_type lazy(seed);
+        lazy();
+        lazy.seed(seed);
+        REQUIRE(lazy == lazy_type(seed));
+        REQUIRE(lazy != lazy_type(static_cast<typename Test::result_type>(seed + 1u)));
+        REQUIRE(lazy_type().complete() == Test());
+    }
+}
+
+#if __cpp_constexpr >= 201304L && MT_TEST_SUPPORTS_WIDTH(32)
+constexpr typename test32::result_type first_value() {
+    freestanding_mersenne_twister::lazy_seed_engine<test32> lazy;
+    return lazy();
+}
+static_assert(first_value() == 3499211612u, "lazy_seed_engine in a constant expression");
+#endif
+}
+
+TEST_CASE( "Lazy seeding" ) {
+#if MT_SUPPORTS_WIDTH(32)
+    SECTION( "mt19937" ) {
+        check_lazy_seed<base32, test32>(5489u);
+        check_lazy_seed<base32, test32>(1u);
+    }
+#endif
+#if MT_SUPPORTS_WIDTH(64)
+    SECTION( "mt19937_64" ) {
+        check_lazy_seed<base64, test64>(5489u);
+        check_lazy_seed<base64, test64>(1u);
+    }
+#endif
+    SECTION( "Other parameters" ) {
+        using both = mt_both<unsigned long long, 24, 17, 13, 5, 0xaee3fau, 3, 0x583863u, 2, 0xd0fef6u, 7, 0xc3a13bu, 11, 0x93caf6u>;
+        check_lazy_seed<typename both::base, typename both::test>(12u);
+        // shift_size == state_size
+        using same = mt_both<unsigned long long, 24, 17, 17, 5, 0xaee3fau, 3, 0x583863u, 2, 0xd0fef6u, 7, 0xc3a13bu, 11, 0x93caf6u>;
+        check_lazy_seed<typename same::base, typename same::test>(12u);
+        // shift_size == 1
+        using one = mt_both<unsigned long long, 24, 17, 1, 5, 0xaee3fau, 3, 0x583863u, 2, 0xd0fef6u, 7, 0xc3a13bu, 11, 0x93caf6u>;
+        check_lazy_seed<typename one::base, typename one::test>(12u);
+    }
+}
+
+#endif
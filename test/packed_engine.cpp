@@ -0,0 +1,96 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_PACKED_ENGINE
+
+#include <vector>
+
+namespace {
+template<class Base, class Packed>
+void check_packed(typename Packed::result_type seed) {
+    constexpr size_t n = Packed::state_size;
+    Base b(seed);
+    Packed p(seed);
+    for (size_t j = 0; j < 3u * n + 5u; ++j) {
+        REQUIRE(p() == b());
+    }
+
+    std::vector<typename Packed::result_type> values;
+    for (size_t count : { size_t{0}, size_t{1}, n - 1u, n, n + 1u, 3u * n + 2u }) {
+        values.assign(count, 0u);
+        REQUIRE(p(values.data(), values.data() + count) == values.data() + count);
+        for (auto x : values) {
+            REQUIRE(x == b());
+        }
+    }
+
+    auto unpacked = p.unpack();
+    REQUIRE(Packed(unpacked) == p);
+    p.discard(2u * n + 3u);
+    unpacked.discard(2u * n + 3u);
+    REQUIRE(p != Packed(seed));
+    for (size_t j = 0; j < n; ++j) {
+        REQUIRE(p() == unpacked());
+    }
+    p.seed(seed);
+    REQUIRE(p == Packed(seed));
+    REQUIRE(Packed() == Packed(Packed::default_seed));
+}
+
+template<class UIntType, size_t w, size_t n, size_t m, size_t r, UIntType a, size_t u, UIntType d, size_t s, UIntType b, size_t t, UIntType c, size_t l, UIntType f>
+using packed = freestanding_mersenne_twister::packed_mersenne_twister_engine<UIntType, w, n, m, r, a, u, d, s, b, t, c, l, f>;
+
+// Narrow word sizes (not chosen for a long period)
+#define MT_TEST_PARAMETERS_16 16, 37, 19, 7, 0xb2a1u, 5, 0xffffu, 4, 0x6c80u, 8, 0xe800u, 9, 0x6f65u
+#define MT_TEST_PARAMETERS_8 8, 73, 37, 7, 0xb9u, 3, 0xffu, 2, 0x9cu, 4, 0xe0u, 5, 0xcdu
+#define MT_TEST_PARAMETERS_12 12, 41, 20, 5, 0xa31u, 4, 0xfffu, 3, 0x6b0u, 6, 0xec0u, 7, 0x3e5u
+
+template<class Packed>
+constexpr bool check_lane_size(size_t lane_size) {
+    return sizeof(typename Packed::lane_type) == lane_size &&
+        sizeof(Packed) <= Packed::state_size * lane_size + sizeof(size_t) + alignof(size_t) - 1u;
+}
+static_assert(check_lane_size<packed<unsigned long long, MT_TEST_PARAMETERS_8>>(1u), "one byte per word when w is 8");
+static_assert(check_lane_size<packed<unsigned long long, MT_TEST_PARAMETERS_16>>(sizeof(unsigned short)), "unsigned short per word when w is 16");
+static_assert(check_lane_size<packed<unsigned long long, MT_TEST_PARAMETERS_12>>(sizeof(unsigned short)), "unsigned short per word when w is 12");
+static_assert(check_lane_size<packed<unsigned long long, 32, 624, 397, 31, 0x9908'b0dfu, 11, 0xffff'ffffu, 7, 0x9d2c'5680u, 15, 0xefc6'0000u, 18, 1'812'433'253u>>(sizeof(unsigned)), "unsigned per word when w is 32");
+}
+
+TEST_CASE( "Packed engines" ) {
+    SECTION( "w = 16" ) {
+        check_packed<mt_base<unsigned long long, MT_TEST_PARAMETERS_16>, packed<unsigned long long, MT_TEST_PARAMETERS_16>>(5489u);
+        check_packed<mt_base<unsigned long long, MT_TEST_PARAMETERS_16>, packed<unsigned, MT_TEST_PARAMETERS_16>>(1u);
+        check_packed<mt_base<unsigned long long, MT_TEST_PARAMETERS_16>, packed<unsigned short, MT_TEST_PARAMETERS_16>>(0xffffu);
+    }
+    SECTION( "w = 8" ) {
+        check_packed<mt_base<unsigned long long, MT_TEST_PARAMETERS_8>, packed<unsigned long long, MT_TEST_PARAMETERS_8>>(5489u);
+        check_packed<mt_base<unsigned long long, MT_TEST_PARAMETERS_8>, packed<unsigned char, MT_TEST_PARAMETERS_8>>(0xffu);
+    }
+    SECTION( "w = 12" ) {
+        check_packed<mt_base<unsigned long long, MT_TEST_PARAMETERS_12>, packed<unsigned long long, MT_TEST_PARAMETERS_12>>(12u);
+    }
+#if MT_SUPPORTS_WIDTH(32)
+    SECTION( "mt19937" ) {
+        check_packed<base32, packed<unsigned long long, 32, 624, 397, 31, 0x9908'b0dfu, 11, 0xffff'ffffu, 7, 0x9d2c'5680u, 15, 0xefc6'0000u, 18, 1'812'433'253u>>(5489u);
+    }
+#endif
+    SECTION( "Narrow result_type" ) {
+        // mersenne_twister_engine itself with result_types that are promoted to int
+        // (which the standard library's does not allow)
+        mt_test<unsigned short, MT_TEST_PARAMETERS_16> e(0xffffu);
+        mt_base<unsigned long long, MT_TEST_PARAMETERS_16> g(0xffffu);
+        std::vector<unsigned short> outputs;
+        for (int i = 0; i < 1000; ++i) {
+            outputs.push_back(e());
+            REQUIRE(outputs.back() == g());
+        }
+        auto reconstructed = decltype(e)::from_outputs(outputs.begin(), outputs.end());
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(reconstructed() == e());
+        }
+        for (unsigned short x : outputs) {
+            REQUIRE(decltype(e)::unscramble(decltype(e)::scramble(x)) == x);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,44 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_RANDOM_ARRAY
+
+namespace {
+template<size_t N, class Test, class Base>
+void check_random_array(typename Test::result_type seed) {
+    const auto values = freestanding_mersenne_twister::make_random_array<N, Test>(seed);
+    REQUIRE(values.size() == N);
+    REQUIRE(values.end() - values.begin() == static_cast<std::ptrdiff_t>(N));
+    Base b(seed);
+    for (auto x : values) {
+        REQUIRE(x == b());
+    }
+}
+
+#if __cpp_constexpr >= 201304L && MT_TEST_SUPPORTS_WIDTH(32)
+constexpr auto table32 = freestanding_mersenne_twister::make_random_array<10000, test32>();
+static_assert(table32[9999] == 4123659995u, "make_random_array<10000, mt19937<>>");
+#endif
+#if __cpp_constexpr >= 201304L && MT_TEST_SUPPORTS_WIDTH(64)
+constexpr auto table64 = freestanding_mersenne_twister::make_random_array<10000, test64>();
+static_assert(table64[9999] == 9981545732273789042u, "make_random_array<10000, mt19937_64<>>");
+#endif
+}
+
+TEST_CASE( "Random arrays" ) {
+#if MT_TEST_SUPPORTS_WIDTH(32)
+    SECTION( "mt19937" ) {
+        check_random_array<1, test32, base32>(5489u);
+        check_random_array<623, test32, base32>(1u);
+        check_random_array<624, test32, base32>(1u);
+        check_random_array<2000, test32, base32>(12345u);
+    }
+#endif
+#if MT_TEST_SUPPORTS_WIDTH(64)
+    SECTION( "mt19937_64" ) {
+        check_random_array<313, test64, base64>(5489u);
+        check_random_array<1000, test64, base64>(1u);
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,67 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_FROM_OUTPUTS
+
+#include <vector>
+
+namespace {
+template<class Engine>
+void check_unscramble(Engine e) {
+    for (int i = 0; i < 1000; ++i) {
+        auto x = e();
+        REQUIRE(Engine::scramble(Engine::unscramble(x)) == x);
+        REQUIRE(Engine::unscramble(Engine::scramble(x)) == x);
+    }
+}
+
+template<class Test, class Base>
+void check_from_outputs(unsigned long long seed, size_t skip, size_t logged) {
+    Base b(seed);
+    mt_base_discard(b, skip);
+    std::vector<typename Base::result_type> log;
+    for (size_t i = 0; i < logged; ++i) log.push_back(b());
+
+    Test t = Test::from_outputs(log.begin(), log.end());
+    for (int i = 0; i < 2000; ++i) {
+        REQUIRE(t() == b());
+    }
+}
+}
+
+TEST_CASE( "Reconstructing from outputs" ) {
+#if MT_SUPPORTS_WIDTH(32)
+    SECTION( "mt19937" ) {
+        check_unscramble(test32(1234u));
+        check_from_outputs<test32, base32>(5489u, 0, 624);
+        check_from_outputs<test32, base32>(5489u, 0, 1000);
+        check_from_outputs<test32, base32>(1u, 17, 624);
+        check_from_outputs<test32, base32>(1u, 624, 1248);
+    }
+#endif
+#if MT_SUPPORTS_WIDTH(64)
+    SECTION( "mt19937_64" ) {
+        check_unscramble(test64(1234u));
+        check_from_outputs<test64, base64>(5489u, 0, 312);
+        check_from_outputs<test64, base64>(5489u, 3, 313);
+        check_from_outputs<test64, base64>(1u, 311, 1000);
+    }
+#endif
+    SECTION( "Other parameters" ) {
+        constexpr size_t w = MT_SUPPORTS_WIDTH(47) ? 47 : MT_MIN_WIDTH;
+        constexpr unsigned long long mask = (1ull << w) - 1ull;
+        using both = mt_both<unsigned long long, w, 17, 13, w / 2u, 0xafce8adbaee3fae0ull & mask,
+                             13, 0x86ec67497b583863ull & mask, 2, 0x8940d4de06d0fef6ull & mask,
+                             1, 0x69526c3559c3a13bull & mask, 31, 0x2ff6fad8e693caf6ull & mask>;
+        check_unscramble(typename both::test(1u));
+        check_from_outputs<typename both::test, typename both::base>(1u, 0, 17);
+        check_from_outputs<typename both::test, typename both::base>(1u, 5, 40);
+    }
+    SECTION( "Tempering shifts of 0 with zero masks" ) {
+        using both = mt_both<unsigned long long, 24, 17, 13, 5, 0xaee3fau, 0, 0u, 0, 0u, 7, 0xc3a13bu, 11, 0x93caf6u>;
+        check_unscramble(typename both::test(1u));
+        check_from_outputs<typename both::test, typename both::base>(1u, 0, 17);
+        check_from_outputs<typename both::test, typename both::base>(12u, 5, 40);
+    }
+}
+
+#endif
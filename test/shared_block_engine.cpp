@@ -0,0 +1,104 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_THREADS
+
+#include <thread>
+#include <vector>
+#include <map>
+
+#include "freestanding_mersenne_twister_threads.h"
+
+namespace {
+template<class SharedEngine>
+void check_blocks(const std::map<unsigned long long, std::vector<test32::result_type>>& blocks, unsigned long long seed) {
+    constexpr size_t n = SharedEngine::block_size;
+    base32 b(static_cast<base32::result_type>(seed));
+    unsigned long long position = 0;
+    for (auto& block : blocks) {
+        REQUIRE(block.second.size() == n);
+        mt_base_discard(b, block.first * n - position);
+        for (auto x : block.second) {
+            REQUIRE(x == b());
+        }
+        position = (block.first + 1u) * n;
+    }
+}
+}
+
+TEST_CASE( "Shared block engine" ) {
+#if MT_SUPPORTS_WIDTH(32)
+    SECTION( "Threads claiming runs" ) {
+        // Small runs, so the handles skip over each other's runs with transitions
+        using shared_engine = freestanding_mersenne_twister::shared_block_engine<test32, 2>;
+        constexpr size_t n = shared_engine::block_size;
+        shared_engine shared(1234u);
+
+        constexpr unsigned thread_count = 4;
+        constexpr unsigned blocks_per_thread = 5;
+        std::vector<std::map<unsigned long long, std::vector<test32::result_type>>> claimed(thread_count);
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&shared, &claimed, t] {
+                shared_engine::handle h(shared);
+                for (unsigned k = 0; k < blocks_per_thread * n; ++k) {
+                    auto x = h();
+                    claimed[t][h.block()].push_back(x);
+                }
+            });
+        }
+        for (std::thread& t : threads) t.join();
+
+        std::map<unsigned long long, std::vector<test32::result_type>> blocks;
+        for (auto& per_thread : claimed) {
+            REQUIRE(per_thread.size() == blocks_per_thread);
+            for (auto& block : per_thread) {
+                REQUIRE(blocks.count(block.first) == 0);
+                blocks.insert(block);
+            }
+        }
+        REQUIRE(blocks.size() == thread_count * blocks_per_thread);
+        // Each thread used 3 runs of 2 blocks
+        for (auto& block : blocks) {
+            REQUIRE(block.first < thread_count * 3u * shared_engine::run_blocks);
+        }
+        check_blocks<shared_engine>(blocks, 1234u);
+    }
+    SECTION( "Jumping over runs" ) {
+        // Runs of jump_threshold blocks, so skipping even one run uses a jump
+        using shared_engine = freestanding_mersenne_twister::shared_block_engine<test32, 4'096>;
+        constexpr size_t n = shared_engine::block_size;
+        shared_engine shared(5489u);
+
+        // Handle k claims run k when it is first used (jumping over k runs), then run 4 + k after using up
+        // its first run (jumping over the 3 runs of the other handles)
+        constexpr unsigned handle_count = 4;
+        std::vector<shared_engine::handle> handles(handle_count, shared_engine::handle(shared));
+        std::map<unsigned long long, std::vector<test32::result_type>> blocks;
+        for (shared_engine::handle& h : handles) {
+            auto x = h();
+            blocks[h.block()].push_back(x);
+            for (size_t k = 1; k < n; ++k) {
+                blocks[h.block()].push_back(h());
+            }
+        }
+        for (shared_engine::handle& h : handles) {
+            for (unsigned long long k = n; k < shared_engine::run_blocks * n; ++k) {
+                static_cast<void>(h());
+            }
+            auto x = h();
+            blocks[h.block()].push_back(x);
+            for (size_t k = 1; k < n; ++k) {
+                blocks[h.block()].push_back(h());
+            }
+        }
+        REQUIRE(blocks.size() == 2u * handle_count);
+        unsigned long long run = 0;
+        for (auto& block : blocks) {
+            REQUIRE(block.first == run++ * shared_engine::run_blocks);
+        }
+        check_blocks<shared_engine>(blocks, 5489u);
+    }
+#endif
+}
+
+#endif
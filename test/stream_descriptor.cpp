@@ -0,0 +1,136 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_STREAM_DESCRIPTOR
+
+#include <algorithm>
+
+#if __has_include(<unistd.h>) && __has_include(<sys/wait.h>)
+#include <unistd.h>
+#include <sys/wait.h>
+#define MT_TEST_HAS_FORK
+#endif
+
+namespace {
+template<class Test, size_t Exponent>
+void check_descriptor(unsigned long long seed, unsigned long long stream, unsigned long long offset) {
+    using descriptor = freestanding_mersenne_twister::stream_descriptor<Test, Exponent>;
+    const descriptor d{ seed, stream, offset };
+
+    unsigned char bytes[descriptor::size_in_bytes];
+    REQUIRE(d.to_bytes(bytes) == bytes + descriptor::size_in_bytes);
+    REQUIRE(descriptor::from_bytes(bytes) == d);
+    REQUIRE(descriptor::from_bytes(bytes) != descriptor{ seed, stream + 1u, offset });
+
+    Test expected(static_cast<typename Test::result_type>(seed));
+    for (unsigned long long k = 0; k < stream; ++k) {
+        expected.discard(1ull << Exponent);
+    }
+    expected.discard(offset);
+    REQUIRE(descriptor::from_bytes(bytes).engine() == expected);
+}
+
+#ifdef MT_TEST_HAS_FORK
+// Stand-in for sending descriptors to other machines: each child process is sent a descriptor
+// through a pipe, expands it and sends back the first values of its engine
+template<class Test, size_t Exponent>
+void check_processes(unsigned long long seed, int processes) {
+    using descriptor = freestanding_mersenne_twister::stream_descriptor<Test, Exponent>;
+    using result_type = typename Test::result_type;
+    constexpr size_t values = 8;
+
+    for (int p = 0; p < processes; ++p) {
+        int to_child[2];
+        int from_child[2];
+        REQUIRE(::pipe(to_child) == 0);
+        REQUIRE(::pipe(from_child) == 0);
+        const pid_t pid = ::fork();
+        REQUIRE(pid >= 0);
+        if (pid == 0) {
+            unsigned char bytes[descriptor::size_in_bytes];
+            size_t received = 0;
+            while (received < sizeof(bytes)) {
+                const ssize_t r = ::read(to_child[0], bytes + received, sizeof(bytes) - received);
+                if (r <= 0) ::_exit(1);
+                received += static_cast<size_t>(r);
+            }
+            Test e = descriptor::from_bytes(bytes).engine();
+            result_type out[values];
+            e(out + 0, out + values);
+            ::_exit(::write(from_child[1], out, sizeof(out)) == static_cast<ssize_t>(sizeof(out)) ? 0 : 1);
+        }
+        ::close(to_child[0]);
+        ::close(from_child[1]);
+
+        const descriptor d{ seed, static_cast<unsigned long long>(p), 1000u * static_cast<unsigned long long>(p) };
+        unsigned char bytes[descriptor::size_in_bytes];
+        d.to_bytes(bytes);
+        REQUIRE(::write(to_child[1], bytes, sizeof(bytes)) == static_cast<ssize_t>(sizeof(bytes)));
+        ::close(to_child[1]);
+
+        result_type received[values];
+        size_t size = 0;
+        for (ssize_t r; size < sizeof(received) && (r = ::read(from_child[0], reinterpret_cast<unsigned char*>(received) + size, sizeof(received) - size)) > 0;) {
+            size += static_cast<size_t>(r);
+        }
+        ::close(from_child[0]);
+        int status = 0;
+        REQUIRE(::waitpid(pid, &status, 0) == pid);
+        REQUIRE(WIFEXITED(status));
+        REQUIRE(WEXITSTATUS(status) == 0);
+        REQUIRE(size == sizeof(received));
+
+        Test expected = d.engine();
+        for (result_type x : received) {
+            REQUIRE(x == expected());
+        }
+    }
+}
+#endif
+}
+
+TEST_CASE( "Stream descriptors" ) {
+#if MT_TEST_SUPPORTS_WIDTH(32)
+    SECTION( "mt19937" ) {
+        check_descriptor<test32, 16>(5489u, 0u, 0u);
+        check_descriptor<test32, 16>(5489u, 3u, 17u);
+        check_descriptor<test32, 10>(0xffff'ffffu, 5u, 1'000u);
+    }
+    SECTION( "Seeds wider than the engine's words" ) {
+        using descriptor = freestanding_mersenne_twister::stream_descriptor<test32, 16>;
+        const descriptor narrow{ 1u, 2u, 3u };
+        const descriptor wide{ (1ull << 32) + 1u, 2u, 3u };
+        REQUIRE(wide.engine() == narrow.engine());
+        REQUIRE(wide == narrow);
+        REQUIRE(wide != descriptor{ 2u, 2u, 3u });
+
+        unsigned char narrow_bytes[descriptor::size_in_bytes];
+        unsigned char wide_bytes[descriptor::size_in_bytes];
+        narrow.to_bytes(narrow_bytes);
+        wide.to_bytes(wide_bytes);
+        REQUIRE(std::equal(narrow_bytes, narrow_bytes + descriptor::size_in_bytes, wide_bytes));
+        REQUIRE(descriptor::from_bytes(wide_bytes).seed == 1u);
+
+        // An out of range seed in the serialised form is read as the seed the engine would use
+        wide_bytes[5] = 0xa5u;
+        REQUIRE(descriptor::from_bytes(wide_bytes) == narrow);
+        REQUIRE(descriptor::from_bytes(wide_bytes).seed == 1u);
+    }
+#endif
+#if MT_TEST_SUPPORTS_WIDTH(64)
+    SECTION( "mt19937_64" ) {
+        check_descriptor<test64, 12>(0x0123'4567'89ab'cdefu, 2u, 313u);
+    }
+#endif
+#if defined(MT_TEST_HAS_FORK) && MT_TEST_SUPPORTS_WIDTH(32)
+    SECTION( "Expanded in other processes" ) {
+        check_processes<test32, 20>(1234u, 4);
+    }
+#endif
+#if defined(MT_TEST_HAS_FORK) && MT_TEST_SUPPORTS_WIDTH(64)
+    SECTION( "Expanded in other processes (default stream spacing)" ) {
+        check_processes<test64, 64>(1234u, 2);
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_THREADS
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "freestanding_mersenne_twister_threads.h"
+
+TEST_CASE( "Thread engine registry" ) {
+#if MT_TEST_SUPPORTS_WIDTH(32)
+    struct tag {};
+    using registry = freestanding_mersenne_twister::thread_engine_registry<test32, 12, tag>;
+
+    SECTION( "Substreams" ) {
+        registry::seed(1234u);
+        test32 expected(1234u);
+        for (unsigned long long k = 0; k < 4; ++k) {
+            REQUIRE(registry::substream(k) == expected);
+            expected.discard(1u << 12);
+        }
+    }
+
+    SECTION( "Each thread gets its own substream" ) {
+        registry::seed(1234u);
+        constexpr unsigned thread_count = 4;
+        std::vector<test32> engines(thread_count);
+        // (Catch's assertions are not thread safe, so the results are checked after joining)
+        std::vector<char> same_engine(thread_count);
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&engines, &same_engine, t] {
+                test32& e = registry::local();
+                same_engine[t] = &e == &registry::local();
+                engines[t] = e;
+                e();
+            });
+        }
+        for (std::thread& t : threads) t.join();
+
+        for (char same : same_engine) {
+            REQUIRE(same);
+        }
+
+        std::vector<test32> expected;
+        for (unsigned k = 0; k < thread_count; ++k) expected.push_back(registry::substream(k));
+        for (const test32& e : engines) {
+            REQUIRE(std::count(expected.begin(), expected.end(), e) == 1);
+        }
+    }
+
+    SECTION( "Reseeding" ) {
+        registry::seed(1u);
+        test32 before = registry::local();
+        before();
+        registry::local()();
+        REQUIRE(registry::local() == before);
+
+        registry::seed(1u);
+        REQUIRE(registry::local() == test32(1u));
+        registry::bind(2);
+        REQUIRE(registry::local() == registry::substream(2));
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,132 @@
+#include "./config.h"
+
+#ifdef MT_TEST_HAS_VIEWS
+
+#include <vector>
+
+#if __has_include(<ranges>)
+#include <ranges>
+#endif
+
+namespace {
+template<class Test, class Base>
+void check_views(unsigned long long seed, size_t skip) {
+    using freestanding_mersenne_twister::block_view;
+    using freestanding_mersenne_twister::value_view;
+    {
+        Test t(seed);
+        Base b(seed);
+        t.discard(skip);
+        mt_base_discard(b, skip);
+        block_view<Test> blocks(t);
+        auto it = blocks.begin();
+        REQUIRE((*it).size() == Test::state_size - skip % Test::state_size);
+        for (int k = 0; k < 4; ++k, ++it) {
+            REQUIRE(it != blocks.end());
+            for (auto x : *it) {
+                REQUIRE(x == b());
+            }
+            REQUIRE(t.i == 0);
+        }
+    }
+    {
+        Test t(seed);
+        Base b(seed);
+        t.discard(skip);
+        mt_base_discard(b, skip);
+        value_view<Test> values(t);
+        auto it = values.begin();
+        for (size_t k = 0; k < 3 * Test::state_size + 1; ++k, ++it) {
+            REQUIRE(*it == b());
+        }
+    }
+    {
+        // Copies and moves in the middle of a block continue from the same value (and share the engine)
+        Test t(seed);
+        Base b(seed);
+        t.discard(skip);
+        mt_base_discard(b, skip);
+        auto* values = new value_view<Test>(t);
+        auto it = values->begin();
+        for (size_t k = 0; k < 5; ++k, ++it) {
+            REQUIRE(*it == b());
+        }
+        value_view<Test> copy(*values);
+        value_view<Test> moved(static_cast<value_view<Test>&&>(*values));
+        delete values;
+        // How many values are left in the block that the views are in
+        const size_t first_block = Test::state_size - skip % Test::state_size;
+        const size_t rest = 5 < first_block ? first_block - 5 : Test::state_size - (5 - first_block) % Test::state_size;
+        std::vector<typename Test::result_type> expected;
+        auto copy_it = copy.begin();
+        for (size_t k = 0; k < 2 * Test::state_size; ++k, ++copy_it) {
+            expected.push_back(b());
+            REQUIRE(*copy_it == expected.back());
+        }
+        auto moved_it = moved.begin();
+        for (size_t k = 0; k < rest; ++k, ++moved_it) {
+            REQUIRE(*moved_it == expected[k]);
+        }
+    }
+    {
+        Test t(seed);
+        Base b(seed);
+        t.discard(skip);
+        mt_base_discard(b, skip);
+        auto* blocks = new block_view<Test>(t);
+        auto it = blocks->begin();
+        const size_t size = (*it).size();
+        block_view<Test> copy(*blocks);
+        block_view<Test> moved(static_cast<block_view<Test>&&>(*blocks));
+        delete blocks;
+        auto copy_block = *copy.begin();
+        auto moved_block = *moved.begin();
+        REQUIRE(copy_block.size() == size);
+        REQUIRE(moved_block.size() == size);
+        for (size_t k = 0; k < size; ++k) {
+            const auto expected = b();
+            REQUIRE(copy_block[k] == expected);
+            REQUIRE(moved_block[k] == expected);
+        }
+    }
+}
+}
+
+TEST_CASE( "Block and value views" ) {
+#if MT_SUPPORTS_WIDTH(32)
+    SECTION( "mt19937" ) {
+        check_views<test32, base32>(5489u, 0);
+        check_views<test32, base32>(5489u, 100);
+    }
+#endif
+#if MT_SUPPORTS_WIDTH(64)
+    SECTION( "mt19937_64" ) {
+        check_views<test64, base64>(5489u, 311);
+    }
+#endif
+#if __cpp_lib_ranges >= 201911L && MT_SUPPORTS_WIDTH(32)
+    SECTION( "Standard ranges" ) {
+        using freestanding_mersenne_twister::block_view;
+        using freestanding_mersenne_twister::value_view;
+        static_assert(std::ranges::input_range<block_view<test32>>);
+        static_assert(std::ranges::input_range<value_view<test32>>);
+        static_assert(std::ranges::contiguous_range<block_view<test32>::block>);
+
+        test32 t(5489u);
+        base32 b(5489u);
+        for (auto x : value_view<test32>(t) | std::views::take(1000)) {
+            REQUIRE(x == b());
+        }
+
+        test32 t2(1u);
+        base32 b2(1u);
+        for (auto block : block_view<test32>(t2) | std::views::take(2)) {
+            for (auto x : block) {
+                REQUIRE(x == b2());
+            }
+        }
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,148 @@
+// mtdc: prints Mersenne Twister parameter sets found by dynamic_creator, one per id, either as
+// mersenne_twister_engine template arguments or as mersenne_twister_parameters initialisers.
+
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "freestanding_mersenne_twister.h"
+#include "freestanding_mersenne_twister_dynamic_creator.h"
+
+namespace {
+
+namespace fmt = freestanding_mersenne_twister;
+
+struct options {
+    unsigned long long word_size = 32;
+    unsigned long long exponent = 521;
+    unsigned long long seed = 4172u;
+    unsigned long long first_id = 0;
+    unsigned long long count = 1;
+    unsigned threads = 0;
+    bool runtime = false;
+};
+
+[[noreturn]] void usage(const char* program, int status) {
+    std::fprintf(status == 0 ? stdout : stderr,
+        "Usage: %s [options] FIRST_ID [COUNT]\n"
+        "Searches for Mersenne Twister parameter sets for ids FIRST_ID to FIRST_ID + COUNT - 1.\n"
+        "\n"
+        "  -w, --word-size W   32 (default) or 64\n"
+        "  -p, --exponent P    period 2**P - 1: 89, 127, 521 (default), 607, 1279 or 2203\n"
+        "  -s, --seed SEED     seed for the search (default 4172)\n"
+        "  -j, --threads N     number of ids searched at once (default: hardware concurrency)\n"
+        "  -r, --runtime       print mersenne_twister_parameters initialisers instead of engine types\n",
+        program);
+    std::exit(status);
+}
+
+bool parse_number(const char* s, unsigned long long& out) {
+    const char* end = s + std::strlen(s);
+    const auto result = std::from_chars(s, end, out);
+    return *s != '\0' && result.ec == std::errc() && result.ptr == end;
+}
+
+options parse_options(int argc, char** argv) {
+    options opts;
+    int positional = 0;
+    for (int k = 1; k < argc; ++k) {
+        const std::string arg = argv[k];
+        auto number = [&]() {
+            unsigned long long x;
+            if (k + 1 >= argc || !parse_number(argv[++k], x)) usage(argv[0], 2);
+            return x;
+        };
+        if (arg == "-h" || arg == "--help") usage(argv[0], 0);
+        else if (arg == "-w" || arg == "--word-size") opts.word_size = number();
+        else if (arg == "-p" || arg == "--exponent") opts.exponent = number();
+        else if (arg == "-s" || arg == "--seed") opts.seed = number();
+        else if (arg == "-j" || arg == "--threads") opts.threads = static_cast<unsigned>(number());
+        else if (arg == "-r" || arg == "--runtime") opts.runtime = true;
+        else if (positional == 0 && parse_number(arg.c_str(), opts.first_id)) ++positional;
+        else if (positional == 1 && parse_number(arg.c_str(), opts.count)) ++positional;
+        else usage(argv[0], 2);
+    }
+    if (positional == 0) usage(argv[0], 2);
+    if (opts.threads == 0u) opts.threads = std::thread::hardware_concurrency();
+    if (opts.threads == 0u) opts.threads = 1u;
+    return opts;
+}
+
+template<class UIntType>
+void print(const options& opts, unsigned long long id, const fmt::mersenne_twister_parameters<UIntType>& p) {
+    const int digits = static_cast<int>(p.word_size / 4u);
+    const auto hex = [](UIntType x) { return static_cast<unsigned long long>(x); };
+    if (opts.runtime) {
+        std::printf("// id %llu\n{ %zu, %zu, %zu, %zu, 0x%0*llxu, %zu, 0x%0*llxu, %zu, 0x%0*llxu, %zu, 0x%0*llxu, %zu, %lluu },\n",
+            id, p.word_size, p.state_size, p.shift_size, p.mask_bits, digits, hex(p.xor_mask),
+            p.tempering_u, digits, hex(p.tempering_d), p.tempering_s, digits, hex(p.tempering_b),
+            p.tempering_t, digits, hex(p.tempering_c), p.tempering_l, hex(p.initialization_multiplier));
+    } else {
+        std::printf("using mt%zu_%llu_%llu = freestanding_mersenne_twister::mersenne_twister_engine<std::uint_least%zu_t, %zu, %zu, %zu, %zu,\n"
+            "        0x%0*llxu, %zu, 0x%0*llxu, %zu, 0x%0*llxu, %zu, 0x%0*llxu, %zu, %lluu>;\n",
+            p.word_size, static_cast<unsigned long long>(p.state_size * p.word_size - p.mask_bits), id,
+            p.word_size, p.word_size, p.state_size, p.shift_size, p.mask_bits, digits, hex(p.xor_mask),
+            p.tempering_u, digits, hex(p.tempering_d), p.tempering_s, digits, hex(p.tempering_b),
+            p.tempering_t, digits, hex(p.tempering_c), p.tempering_l, hex(p.initialization_multiplier));
+    }
+}
+
+template<class UIntType, size_t WordSize, size_t Exponent>
+int run(const options& opts) {
+    using creator = fmt::dynamic_creator<UIntType, WordSize, Exponent>;
+    if (opts.count == 0u) return 0;
+    if (((opts.first_id + opts.count - 1u) >> creator::id_bits) != 0u) {
+        std::fprintf(stderr, "mtdc: ids must be less than %llu\n", 1ull << creator::id_bits);
+        return 1;
+    }
+    std::vector<fmt::mersenne_twister_parameters<UIntType>> results(opts.count);
+    std::vector<char> found(opts.count);
+    std::atomic<unsigned long long> next{0};
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < opts.threads; ++t) {
+        threads.emplace_back([&] {
+            for (unsigned long long k; (k = next.fetch_add(1u)) < opts.count;) {
+                found[k] = creator::create(opts.first_id + k, opts.seed, results[k]);
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    for (unsigned long long k = 0; k < opts.count; ++k) {
+        if (!found[k]) {
+            std::fprintf(stderr, "mtdc: no parameters found for id %llu\n", opts.first_id + k);
+            return 1;
+        }
+        print(opts, opts.first_id + k, results[k]);
+    }
+    return 0;
+}
+
+template<class UIntType, size_t WordSize>
+int run_exponent(const options& opts) {
+    switch (opts.exponent) {
+        case 89: return run<UIntType, WordSize, 89>(opts);
+        case 127: return run<UIntType, WordSize, 127>(opts);
+        case 521: return run<UIntType, WordSize, 521>(opts);
+        case 607: return run<UIntType, WordSize, 607>(opts);
+        case 1279: return run<UIntType, WordSize, 1279>(opts);
+        case 2203: return run<UIntType, WordSize, 2203>(opts);
+        default:
+            std::fprintf(stderr, "mtdc: unsupported exponent %llu\n", opts.exponent);
+            return 2;
+    }
+}
+
+}
+
+int main(int argc, char** argv) {
+    const options opts = parse_options(argc, argv);
+    if (opts.word_size == 32u) return run_exponent<fmt::detail::uint_least32_t, 32>(opts);
+    if (opts.word_size == 64u) return run_exponent<fmt::detail::uint_least64_t, 64>(opts);
+    std::fprintf(stderr, "mtdc: unsupported word size %llu\n", opts.word_size);
+    return 2;
+}
@@ -0,0 +1,281 @@
+// mtgen: writes values from mt19937 or mt19937_64 to a file or stdout.
+//
+// The output is always the sequence a single engine would generate. With more than one thread, the sequence is
+// split into chunks, and each thread starts on its own chunk and jumps over the other threads' chunks with
+// mersenne_twister_jump. Raw output to a regular file given with --output is written through a memory mapping;
+// anything else (including stdout, which might be a file being appended to) is generated a round of chunks at a
+// time and written in order.
+
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "freestanding_mersenne_twister.h"
+
+namespace {
+
+namespace fmt = freestanding_mersenne_twister;
+
+struct options {
+    std::string engine = "mt19937";
+    unsigned long long seed = 5489u;
+    unsigned long long count = 0;
+    bool count_is_bytes = false;
+    bool text = false;
+    std::string output;
+    unsigned threads = 0;
+    unsigned long long chunk_values = 1u << 22;
+    bool quiet = false;
+};
+
+[[noreturn]] void usage(const char* program, int status) {
+    std::fprintf(status == 0 ? stdout : stderr,
+        "Usage: %s [options] COUNT\n"
+        "Writes COUNT values (or bytes with --bytes) generated by a Mersenne Twister engine.\n"
+        "\n"
+        "  -e, --engine ENGINE   mt19937 (default) or mt19937_64\n"
+        "  -s, --seed SEED       seed for the engine (default 5489)\n"
+        "  -b, --bytes           COUNT is a number of bytes of raw output\n"
+        "  -t, --text            write decimal values, one per line, instead of raw little endian words\n"
+        "  -o, --output FILE     write to FILE instead of stdout\n"
+        "  -j, --threads N       number of threads (default: hardware concurrency)\n"
+        "      --chunk N         values generated by a thread before it jumps (default 4194304)\n"
+        "  -q, --quiet           do not report throughput on stderr\n",
+        program);
+    std::exit(status);
+}
+
+bool parse_number(const char* s, unsigned long long& out) {
+    const char* end = s + std::strlen(s);
+    const auto result = std::from_chars(s, end, out);
+    return *s != '\0' && result.ec == std::errc() && result.ptr == end;
+}
+
+options parse_options(int argc, char** argv) {
+    options opts;
+    bool have_count = false;
+    for (int k = 1; k < argc; ++k) {
+        const std::string arg = argv[k];
+        auto value = [&]() -> const char* {
+            if (k + 1 >= argc) usage(argv[0], 2);
+            return argv[++k];
+        };
+        auto number = [&]() {
+            unsigned long long x;
+            if (!parse_number(value(), x)) usage(argv[0], 2);
+            return x;
+        };
+        if (arg == "-h" || arg == "--help") usage(argv[0], 0);
+        else if (arg == "-e" || arg == "--engine") opts.engine = value();
+        else if (arg == "-s" || arg == "--seed") opts.seed = number();
+        else if (arg == "-b" || arg == "--bytes") opts.count_is_bytes = true;
+        else if (arg == "-t" || arg == "--text") opts.text = true;
+        else if (arg == "-o" || arg == "--output") opts.output = value();
+        else if (arg == "-j" || arg == "--threads") opts.threads = static_cast<unsigned>(number());
+        else if (arg == "--chunk") opts.chunk_values = number();
+        else if (arg == "-q" || arg == "--quiet") opts.quiet = true;
+        else if (!have_count && parse_number(arg.c_str(), opts.count)) have_count = true;
+        else usage(argv[0], 2);
+    }
+    if (!have_count || opts.chunk_values == 0u || (opts.engine != "mt19937" && opts.engine != "mt19937_64") ||
+        (opts.text && opts.count_is_bytes)) {
+        usage(argv[0], 2);
+    }
+    if (opts.threads == 0u) opts.threads = std::thread::hardware_concurrency();
+    if (opts.threads == 0u) opts.threads = 1u;
+    return opts;
+}
+
+bool write_all(int fd, const char* data, size_t size) {
+    while (size != 0u) {
+        const ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+template<class Engine>
+struct generator {
+    using result_type = typename Engine::result_type;
+    static constexpr size_t bytes_per_value = Engine::word_size / 8u;
+    // Enough for the decimal digits of a 64 bit number and a newline
+    static constexpr size_t max_text_bytes = 21u;
+
+    const options& opts;
+    unsigned long long values;
+    unsigned long long bytes;
+
+    explicit generator(const options& opts) : opts(opts),
+        values(opts.count_is_bytes ? (opts.count + bytes_per_value - 1u) / bytes_per_value : opts.count),
+        bytes(opts.count_is_bytes ? opts.count : opts.count * bytes_per_value) {}
+
+    unsigned long long chunk_count() const {
+        return (values + opts.chunk_values - 1u) / opts.chunk_values;
+    }
+
+    unsigned long long chunk_size(unsigned long long chunk) const {
+        const unsigned long long first = chunk * opts.chunk_values;
+        return values - first < opts.chunk_values ? values - first : opts.chunk_values;
+    }
+
+    // Raw bytes of chunk `chunk` (the last chunk can end part way through a value)
+    unsigned long long chunk_bytes(unsigned long long chunk) const {
+        const unsigned long long first = chunk * opts.chunk_values * bytes_per_value;
+        const unsigned long long size = chunk_size(chunk) * bytes_per_value;
+        return bytes - first < size ? bytes - first : size;
+    }
+
+    // Engines at the start of each thread's first chunk, and the jump from the end of one of a
+    // thread's chunks to the start of its next one (empty with one thread, which has no chunks to skip)
+    std::vector<Engine> starts(unsigned thread_count, std::optional<fmt::mersenne_twister_jump<Engine>>& skip) const {
+        std::vector<Engine> result(thread_count, Engine(static_cast<result_type>(opts.seed)));
+        if (thread_count > 1u) {
+            const fmt::mersenne_twister_jump<Engine> one_chunk(opts.chunk_values);
+            for (unsigned t = 1; t < thread_count; ++t) {
+                result[t] = result[t - 1u];
+                one_chunk.apply(result[t]);
+            }
+            skip.emplace(opts.chunk_values * (thread_count - 1u));
+        }
+        return result;
+    }
+
+    static void fill_raw(Engine& e, unsigned char* dest, unsigned long long size) {
+        fmt::byte_generator<Engine> g(e);
+        g.generate_bytes(dest, static_cast<size_t>(size));
+        e = g.base();
+    }
+
+    static size_t fill_text(Engine& e, char* dest, unsigned long long count) {
+        char* p = dest;
+        result_type batch[Engine::state_size];
+        while (count != 0u) {
+            const size_t n = count < Engine::state_size ? static_cast<size_t>(count) : Engine::state_size;
+            e(batch + 0, batch + n);
+            for (size_t k = 0; k < n; ++k) {
+                p = std::to_chars(p, p + max_text_bytes, batch[k]).ptr;
+                *p++ = '\n';
+            }
+            count -= n;
+        }
+        return static_cast<size_t>(p - dest);
+    }
+
+    // Raw output straight into a memory mapped file: each thread writes its chunks in place
+    void run_mapped(unsigned char* output, unsigned thread_count) const {
+        std::optional<fmt::mersenne_twister_jump<Engine>> skip;
+        std::vector<Engine> engines = starts(thread_count, skip);
+        std::vector<std::thread> threads;
+        const unsigned long long chunks = chunk_count();
+        for (unsigned t = 0; t < thread_count; ++t) {
+            threads.emplace_back([this, &engines, &skip, output, chunks, thread_count, t] {
+                Engine& e = engines[t];
+                for (unsigned long long chunk = t; chunk < chunks; chunk += thread_count) {
+                    if (chunk != t && skip) skip->apply(e);
+                    fill_raw(e, output + chunk * opts.chunk_values * bytes_per_value, chunk_bytes(chunk));
+                }
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+    }
+
+    // Generates a round of chunks (one per thread) into buffers, then writes them in order
+    bool run_streamed(int fd, unsigned thread_count) const {
+        std::optional<fmt::mersenne_twister_jump<Engine>> skip;
+        std::vector<Engine> engines = starts(thread_count, skip);
+        const size_t buffer_size = static_cast<size_t>(opts.chunk_values) * (opts.text ? max_text_bytes : bytes_per_value);
+        std::vector<std::vector<char>> buffers(thread_count, std::vector<char>(buffer_size));
+        std::vector<size_t> sizes(thread_count);
+        const unsigned long long chunks = chunk_count();
+        for (unsigned long long round = 0; round < chunks; round += thread_count) {
+            std::vector<std::thread> threads;
+            for (unsigned t = 0; t < thread_count && round + t < chunks; ++t) {
+                threads.emplace_back([this, &engines, &skip, &buffers, &sizes, round, t] {
+                    const unsigned long long chunk = round + t;
+                    Engine& e = engines[t];
+                    if (round != 0u && skip) skip->apply(e);
+                    if (opts.text) {
+                        sizes[t] = fill_text(e, buffers[t].data(), chunk_size(chunk));
+                    } else {
+                        sizes[t] = static_cast<size_t>(chunk_bytes(chunk));
+                        fill_raw(e, reinterpret_cast<unsigned char*>(buffers[t].data()), sizes[t]);
+                    }
+                });
+            }
+            for (std::thread& thread : threads) thread.join();
+            for (unsigned t = 0; t < thread_count && round + t < chunks; ++t) {
+                if (!write_all(fd, buffers[t].data(), sizes[t])) return false;
+            }
+        }
+        return true;
+    }
+
+    int run() const {
+        const unsigned thread_count = static_cast<unsigned long long>(opts.threads) > chunk_count() ?
+            static_cast<unsigned>(chunk_count() == 0u ? 1u : chunk_count()) : opts.threads;
+        const auto start = std::chrono::steady_clock::now();
+
+        int fd = STDOUT_FILENO;
+        if (!opts.output.empty()) {
+            fd = ::open(opts.output.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0666);
+            if (fd < 0) {
+                std::fprintf(stderr, "mtgen: cannot open %s: %s\n", opts.output.c_str(), std::strerror(errno));
+                return 1;
+            }
+        }
+
+        // Only the file opened (and truncated) here: stdout is always written as a stream, so that
+        // e.g. `mtgen ... >> file` appends instead of overwriting the file
+        struct stat st;
+        const bool mappable = fd != STDOUT_FILENO && !opts.text && bytes != 0u && ::fstat(fd, &st) == 0 &&
+            S_ISREG(st.st_mode) && ::ftruncate(fd, static_cast<off_t>(bytes)) == 0;
+        bool ok = true;
+        void* mapping = mappable ? ::mmap(nullptr, static_cast<size_t>(bytes), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+        if (mapping != MAP_FAILED) {
+            run_mapped(static_cast<unsigned char*>(mapping), thread_count);
+            ok = ::munmap(mapping, static_cast<size_t>(bytes)) == 0;
+        } else {
+            ok = run_streamed(fd, thread_count);
+        }
+        if (fd != STDOUT_FILENO) ok = ::close(fd) == 0 && ok;
+        if (!ok) {
+            std::fprintf(stderr, "mtgen: write failed: %s\n", std::strerror(errno));
+            return 1;
+        }
+
+        if (!opts.quiet) {
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            std::fprintf(stderr, "mtgen: %llu values in %.3f s (%.1f Mvalues/s, %u threads%s)\n",
+                values, elapsed.count(), static_cast<double>(values) / elapsed.count() / 1e6,
+                thread_count, mapping != MAP_FAILED ? ", memory mapped" : "");
+        }
+        return 0;
+    }
+};
+
+}
+
+int main(int argc, char** argv) {
+    const options opts = parse_options(argc, argv);
+    if (opts.engine == "mt19937_64") {
+        return generator<fmt::mt19937_64<>>(opts).run();
+    }
+    return generator<fmt::mt19937<>>(opts).run();
+}
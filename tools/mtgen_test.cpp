@@ -0,0 +1,172 @@
+// mtgen_test: runs mtgen (the path given as the only argument) and checks that its output is byte-for-byte
+// what std::mt19937 or std::mt19937_64 would generate, with one and more threads and to each kind of output.
+
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+const char* mtgen;
+int failures = 0;
+
+void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::fprintf(stderr, "mtgen_test: FAILED: %s\n", what.c_str());
+        ++failures;
+    }
+}
+
+// Raw little endian bytes of the first `count` values
+template<class Engine>
+std::string expected_raw(unsigned long long seed, unsigned long long count) {
+    constexpr size_t bytes_per_value = Engine::word_size / 8u;
+    Engine e(static_cast<typename Engine::result_type>(seed));
+    std::string result;
+    result.reserve(static_cast<size_t>(count * bytes_per_value));
+    for (unsigned long long n = 0; n < count; ++n) {
+        const auto x = e();
+        for (size_t k = 0; k < bytes_per_value; ++k) {
+            result.push_back(static_cast<char>(static_cast<unsigned char>(x >> (8u * k))));
+        }
+    }
+    return result;
+}
+
+template<class Engine>
+std::string expected_text(unsigned long long seed, unsigned long long count) {
+    Engine e(static_cast<typename Engine::result_type>(seed));
+    std::string result;
+    for (unsigned long long k = 0; k < count; ++k) {
+        result += std::to_string(e());
+        result += '\n';
+    }
+    return result;
+}
+
+std::string read_file(const std::string& path) {
+    std::string result;
+    if (std::FILE* f = std::fopen(path.c_str(), "rb")) {
+        char buffer[65536];
+        size_t n;
+        while ((n = std::fread(buffer, 1, sizeof(buffer), f)) != 0u) result.append(buffer, n);
+        std::fclose(f);
+    }
+    return result;
+}
+
+void write_file(const std::string& path, const std::string& contents) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (f == nullptr) return;
+    std::fwrite(contents.data(), 1, contents.size(), f);
+    std::fclose(f);
+}
+
+// Runs mtgen with `args`, with stdout going to `out`
+bool run(const std::vector<std::string>& args, int out) {
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(mtgen));
+    for (const std::string& arg : args) argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+    const pid_t pid = ::fork();
+    if (pid < 0) return false;
+    if (pid == 0) {
+        if (::dup2(out, STDOUT_FILENO) < 0) ::_exit(127);
+        ::execv(mtgen, argv.data());
+        ::_exit(127);
+    }
+    int status;
+    if (::waitpid(pid, &status, 0) != pid) return false;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// mtgen's stdout through a pipe
+std::string run_to_pipe(const std::vector<std::string>& args) {
+    const std::string path = "mtgen_test_pipe.bin";
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    int pipe_fds[2];
+    if (fd < 0 || ::pipe(pipe_fds) != 0) return "";
+    // `cat` drains the pipe into a file, so mtgen sees a pipe and not a regular file
+    const pid_t cat = ::fork();
+    if (cat == 0) {
+        ::dup2(pipe_fds[0], STDIN_FILENO);
+        ::dup2(fd, STDOUT_FILENO);
+        ::close(pipe_fds[1]);
+        ::execlp("cat", "cat", static_cast<char*>(nullptr));
+        ::_exit(127);
+    }
+    ::close(pipe_fds[0]);
+    const bool ok = run(args, pipe_fds[1]);
+    ::close(pipe_fds[1]);
+    ::close(fd);
+    int status;
+    ::waitpid(cat, &status, 0);
+    return ok ? read_file(path) : "";
+}
+
+template<class Engine>
+void check_engine(const char* engine, unsigned long long seed, unsigned long long count, unsigned long long chunk) {
+    const std::string seed_string = std::to_string(seed);
+    const std::string count_string = std::to_string(count);
+    const std::string raw = expected_raw<Engine>(seed, count);
+    for (const char* threads : { "1", "3" }) {
+        const std::string name = std::string(engine) + " -j " + threads + " --chunk " + std::to_string(chunk) + " " + count_string;
+        const std::vector<std::string> args = { "-q", "-e", engine, "-s", seed_string, "-j", threads, "--chunk", std::to_string(chunk) };
+        auto with = [&args](std::initializer_list<std::string> more) {
+            std::vector<std::string> result = args;
+            result.insert(result.end(), more);
+            return result;
+        };
+
+        // Memory mapped
+        const std::string output = "mtgen_test_output.bin";
+        check(run(with({ "-o", output, count_string }), STDOUT_FILENO) && read_file(output) == raw, name + " -o");
+
+        // Streamed to a pipe
+        check(run_to_pipe(with({ count_string })) == raw, name + " | pipe");
+
+        // Streamed to stdout appending to a regular file, which must not be truncated
+        const std::string prefix = "existing contents\n";
+        write_file(output, prefix);
+        const int fd = ::open(output.c_str(), O_WRONLY | O_APPEND);
+        check(fd >= 0 && run(with({ count_string }), fd) && read_file(output) == prefix + raw, name + " >> file");
+        if (fd >= 0) ::close(fd);
+
+        // A number of bytes ending part way through a value
+        const std::string byte_count = std::to_string(count * (Engine::word_size / 8u) - 3u);
+        check(run_to_pipe(with({ "-b", byte_count })) == raw.substr(0, raw.size() - 3u), name + " -b");
+        check(run(with({ "-b", "-o", output, byte_count }), STDOUT_FILENO) && read_file(output) == raw.substr(0, raw.size() - 3u), name + " -b -o");
+
+        check(run_to_pipe(with({ "-t", count_string })) == expected_text<Engine>(seed, count), name + " -t");
+        std::remove(output.c_str());
+    }
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::fprintf(stderr, "Usage: %s MTGEN\n", argv[0]);
+        return 2;
+    }
+    mtgen = argv[1];
+
+    // More than one (default sized) chunk
+    check_engine<std::mt19937>("mt19937", 5489u, (1u << 22) + 1000u, 1u << 22);
+    check_engine<std::mt19937_64>("mt19937_64", 1234u, (1u << 22) + 1000u, 1u << 22);
+    // Many small chunks, with some threads getting more of them than others
+    check_engine<std::mt19937>("mt19937", 1u, 10007u, 1000u);
+    check_engine<std::mt19937_64>("mt19937_64", 42u, 10007u, 999u);
+
+    std::remove("mtgen_test_pipe.bin");
+    if (failures != 0) return 1;
+    std::puts("mtgen_test: all tests passed");
+    return 0;
+}